@@ -53,6 +53,7 @@
 #include "widget/gui_container.h"
 #include "widget/gui_debugbox.h"
 #include "widget/gui_list_container.h"
+#include "widget/gui_waterfall.h"
 #include "gui/gui_keyboard.h"
 #include "gui/gui_lcd.h"
 #include "netconn_server.h"
@@ -75,6 +76,7 @@ uint8_t gui_graph_callback(gui_handle_p h, gui_wc_t ctrl, gui_widget_param_t* pa
 
 /* List of GUI widget IDs */
 #define GUI_ID_GRAPH_FFT            (GUI_ID_USER + 0x0001)
+#define GUI_ID_WATERFALL_FFT        (GUI_ID_USER + 0x0002)
 
 /* List of fonts */
 extern gui_const gui_font_t GUI_Font_Arial_Bold_18;
@@ -146,26 +146,29 @@ uint32_t processed_count_divider;
  */
 void
 user_thread(void const * arg) {
-    gui_handle_p h, h_text;
+    gui_handle_p h, h_text, h_waterfall;
     gui_graph_data_p d;
     size_t i, j;
     int32_t* psrc = NULL;
     uint32_t update = 0;
-    float32_t max_value;
-    uint32_t max_index;
     
-    h = gui_graph_create(GUI_ID_GRAPH_FFT, 10, 10, 780, 400, NULL, gui_graph_callback, 0);
-    d = gui_graph_data_create(0, GUI_GRAPH_TYPE_YT, (FFT_SIZE / 2));
+    h = gui_graph_create(GUI_ID_GRAPH_FFT, 10, 10, 780, 200, NULL, gui_graph_callback, 0);
+    d = gui_graph_data_createex(0, GUI_GRAPH_TYPE_BARS, GUI_GRAPH_DATA_FORMAT_FLOAT, (FFT_SIZE / 2));
     gui_graph_attachdata(h, d);                 /* Attach data to graph */
     
     gui_graph_setminx(h, 0);
     gui_graph_setminy(h, 0);
     
-    gui_graph_setmaxx(h, (FFT_SIZE / 2) - 1);
+    gui_graph_setmaxx(h, (FFT_SIZE / 2));       /* Each bar covers one unit */
     gui_graph_setmaxy(h, 1000);
     gui_graph_zoomreset(h);
     
     gui_graph_data_setcolor(d, GUI_COLOR_BLUE);
+    gui_graph_data_setpeakdecay(d, 10);         /* Peaks fall slowly after loud sound */
+    
+    /* Create spectrogram with history of FFT results */
+    h_waterfall = gui_waterfall_create(GUI_ID_WATERFALL_FFT, 10, 215, 780, 190, NULL, NULL, 0);
+    gui_waterfall_setrange(h_waterfall, 0, 1000);
     
     /* Create texts for band values */
     h_text = gui_textview_create(0, 10, 410, 780, 50, NULL, NULL, 0);
@@ -216,7 +219,6 @@ user_thread(void const * arg) {
             
             /* Check if UART is free to send new data */
             if (++update) {
-                float32_t scale;
                 update = 0;
                 
                 /* Process with Real-FFT */
@@ -229,19 +231,11 @@ user_thread(void const * arg) {
                     audio_buff_fft_out_real[i] /= FFT_SIZE;
                 }
                 
-//                /* Calculate max value and scale */
-//                arm_max_f32(audio_buff_fft_out_real, ARR_SIZE(audio_buff_fft_out_real), &max_value, &max_index);
-//                scale = 32767.0f / max_value;
-//                
-//                /* Add data to plot */
-//                for (i = 0; i < ARR_SIZE(audio_buff_fft_out_real); i++) {
-//                    //gui_graph_data_addvalue(d, 0, (int16_t)(audio_buff_fft_out_real[i] * scale));
-//                }
-//                
-//                /* Set maximal graph value */
-//                gui_graph_setmaxy(h, max_value * scale);
-//                gui_graph_zoomreset(h);         /* Reset zoom to default */
-//                gui_widget_invalidate(h);
+                /* Set all data to plot at once, graph is invalidated only once */
+                gui_protect(1);                 /* GUI thread may draw widgets at the same time */
+                gui_graph_data_setvalues(d, audio_buff_fft_out_real, ARR_SIZE(audio_buff_fft_out_real));
+                gui_waterfall_addrow(h_waterfall, audio_buff_fft_out_real, ARR_SIZE(audio_buff_fft_out_real));
+                gui_unprotect(1);
                 
                 /* Calculate sum values */
                 processed_count++;              /* Increase processed count used for averaging */
@@ -33,6 +33,7 @@
 #define GUI_INTERNAL
 #include "gui/gui_private.h"
 #include "gui/gui.h"
+#include "widget/gui_graph.h"
 #include "system/gui_sys.h"
 
 /**
@@ -41,91 +42,130 @@
 gui_t GUI;
 
 /**
- * \brief           Clips are required to draw widget
+ * \brief           Calculate clipping regions of widget from clipping region of its parent
+ *
+ *                  Clipping region of widget is intersection of parent clipping region and widget rectangle.
+ *                  Children widgets are additionally limited to inner area of widget.
+ *
+ *                  Regions are passed down during tree traversal, thus each widget
+ *                  does not need to walk its parents again to calculate visible area
  * \param[in]       h: Widget handle
+ * \param[in]       parent_clip: Clipping region for children of parent widget
+ * \param[out]      clip: Clipping region of widget
+ * \param[out]      children_clip: Clipping region for children of widget
  */
 static void
-check_disp_clipping(gui_handle_p h) {
-#if !GUI_CFG_USE_POS_SIZE_CACHE
+get_clipping_region(gui_handle_p h, const gui_display_t* parent_clip, gui_display_t* clip, gui_display_t* children_clip) {
     gui_dim_t x, y, wi, hi;
-#endif /* !GUI_CFG_USE_POS_SIZE_CACHE */
     
-    /* Copy current setup */
-    memcpy(&GUI.display_temp, &GUI.display, sizeof(GUI.display_temp));
+    x = gui_widget_getabsolutex(h);
+    y = gui_widget_getabsolutey(h);
+    wi = gui_widget_getwidth(h);
+    hi = gui_widget_getheight(h);
     
-#if GUI_CFG_USE_POS_SIZE_CACHE
-    if (GUI.display_temp.x1 == GUI_DIM_MAX || GUI.display_temp.x1 < h->abs_visible_x1) {
-        GUI.display_temp.x1 = h->abs_visible_x1;
-    }
-    if (GUI.display_temp.y1 == GUI_DIM_MAX || GUI.display_temp.y1 < h->abs_visible_y1) {
-        GUI.display_temp.y1 = h->abs_visible_y1;
-    }
-    if (GUI.display_temp.x2 == GUI_DIM_MIN || GUI.display_temp.x2 > h->abs_visible_x2) {
-        GUI.display_temp.x2 = h->abs_visible_x2;
-    }
-    if (GUI.display_temp.y2 == GUI_DIM_MIN || GUI.display_temp.y2 > h->abs_visible_y2) {
-        GUI.display_temp.y2 = h->abs_visible_y2;
-    }
-#else /* GUI_CFG_USE_POS_SIZE_CACHE */
+    /* Visible part of widget itself */
+    clip->x1 = GUI_MAX(parent_clip->x1, x);
+    clip->y1 = GUI_MAX(parent_clip->y1, y);
+    clip->x2 = GUI_MIN(parent_clip->x2, x + wi);
+    clip->y2 = GUI_MIN(parent_clip->y2, y + hi);
+    
+    /* Visible part of widget inner area for children widgets */
+    x += gui_widget_getpaddingleft(h);
+    y += gui_widget_getpaddingtop(h);
+    children_clip->x1 = GUI_MAX(clip->x1, x);
+    children_clip->y1 = GUI_MAX(clip->y1, y);
+    children_clip->x2 = GUI_MIN(clip->x2, x + gui_widget_getinnerwidth(h));
+    children_clip->y2 = GUI_MIN(clip->y2, y + gui_widget_getinnerheight(h));
+}
 
-    /* Set widget itself first */
-    x = gui_widget_getabsolutex(h); 
-    y = gui_widget_getabsolutey(h); 
-    wi = gui_widget_getwidth(h);   
-    hi = gui_widget_getheight(h);   
+/**
+ * \brief           Get clipping region for top level widgets
+ * \param[out]      clip: Clipping region for widgets without parent
+ * \param[in]       use_display: Set to `1` to limit region to currently invalidated area
+ */
+static void
+get_root_clipping_region(gui_display_t* clip, uint8_t use_display) {
+    clip->x1 = 0;
+    clip->y1 = 0;
+    clip->x2 = GUI.lcd.width;
+    clip->y2 = GUI.lcd.height;
     
-    /* Step 1: Set active clipping area only for current widget */
-    if (GUI.display_temp.x1 == GUI_DIM_MAX || GUI.display_temp.x1 < x) {
-        GUI.display_temp.x1 = x;
-    }
-    if (GUI.display_temp.y1 == GUI_DIM_MAX || GUI.display_temp.y1 < y) {
-        GUI.display_temp.y1 = y;
+    /* Invalid coordinates mean there is no limitation */
+    if (use_display) {
+        if (GUI.display.x1 != GUI_DIM_MAX) { clip->x1 = GUI_MAX(clip->x1, GUI.display.x1); }
+        if (GUI.display.y1 != GUI_DIM_MAX) { clip->y1 = GUI_MAX(clip->y1, GUI.display.y1); }
+        if (GUI.display.x2 != GUI_DIM_MIN) { clip->x2 = GUI_MIN(clip->x2, GUI.display.x2); }
+        if (GUI.display.y2 != GUI_DIM_MIN) { clip->y2 = GUI_MIN(clip->y2, GUI.display.y2); }
     }
-    if (GUI.display_temp.x2 == GUI_DIM_MIN || GUI.display_temp.x2 > (x + wi)) {
-        GUI.display_temp.x2 = x + wi;
+}
+
+#if GUI_CFG_USE_REDRAW_SLICE || __DOXYGEN__
+
+/**
+ * \brief           Check if time for current redraw slice has expired
+ *
+ *                  Once expired, widget tree traversal stops and continues with next slice
+ * \return          `1` if slice expired, `0` otherwise
+ */
+static uint8_t
+redraw_slice_expired(void) {
+    if (!GUI.redraw_slice.expired && (gui_sys_now() - GUI.redraw_slice.start) >= GUI_CFG_REDRAW_SLICE_TIME) {
+        GUI.redraw_slice.expired = 1;
     }
-    if (GUI.display_temp.y2 == GUI_DIM_MIN || GUI.display_temp.y2 > (y + hi)) {
-        GUI.display_temp.y2 = y + hi;
+    return GUI.redraw_slice.expired;
+}
+
+#endif /* GUI_CFG_USE_REDRAW_SLICE || __DOXYGEN__ */
+
+/**
+ * \brief           Check if any of direct children still needs redraw
+ *
+ *                  Children skipped during redraw (outside clipping region or covered by siblings)
+ *                  keep their flags. Parent must keep \ref GUI_FLAG_CHILD_REDRAW flag in this case,
+ *                  otherwise later invalidation of their children would not reach root widget
+ * \param[in]       parent: Parent widget handle
+ * \return          `1` if any child has redraw flags set, `0` otherwise
+ */
+static uint8_t
+children_need_redraw(gui_handle_p parent) {
+    gui_handle_p h;
+
+    GUI_LINKEDLIST_WIDGETSLISTNEXT(parent, h) {
+        if (guii_widget_getflag(h, GUI_FLAG_REDRAW | GUI_FLAG_CHILD_REDRAW)) {
+            return 1;
+        }
     }
-    
-    /*
-     * Step 2: Set active clipping area, combining all parent together
-     * 
-     * Process all parent widgets and check what is the position of them
-     * Make sure that on current widget we only draw actual visible area
-     */
-    for (; h != NULL; h = guii_widget_getparent(h)) {
-        x = guii_widget_getparentabsolutex(h);     /* Parent absolute X position for inner widgets */
-        y = guii_widget_getparentabsolutey(h);     /* Parent absolute Y position for inner widgets */
-        wi = guii_widget_getparentinnerwidth(h);   /* Get parent inner width */
-        hi = guii_widget_getparentinnerheight(h);  /* Get parent inner height */
-
-        GUI.display_temp.x1 = GUI_MAX(GUI.display_temp.x1, x);
-        GUI.display_temp.x2 = GUI_MIN(GUI.display_temp.x2, x + wi);
-        GUI.display_temp.y1 = GUI_MAX(GUI.display_temp.y1, y);
-        GUI.display_temp.y2 = GUI_MIN(GUI.display_temp.y2, y + hi);
-    }
-#endif /* !GUI_CFG_USE_POS_SIZE_CACHE */
+    return 0;
 }
 
 /**
  * \brief           Redraw all widgets of selected parent
  * \param[in]       parent: Parent widget handle to draw widgets on
+ * \param[in]       parent_clip: Clipping region for children of parent widget
  * \param[in]       force_redraw: Set to 1 to force drawing all widgets on linked list
  * \return          Number of widgets redrawn
  */
 static uint32_t
-redraw_widgets(gui_handle_p parent, uint8_t force_redraw) {
+redraw_widgets(gui_handle_p parent, const gui_display_t* parent_clip, uint8_t force_redraw) {
     gui_handle_p h;
+    gui_display_t clip, children_clip, disp;
     uint32_t cnt = 0;
     static uint32_t level = 0;
 
     /* Go through all elements of parent */
     GUI_LINKEDLIST_WIDGETSLISTNEXT(parent, h) {
         if (!guii_widget_isvisible(h)) {            /* Check if visible */
-            guii_widget_clrflag(h, GUI_FLAG_REDRAW);/* Clear flag to be sure */
+            guii_widget_clrflag(h, GUI_FLAG_REDRAW | GUI_FLAG_CHILD_REDRAW | GUI_FLAG_DRAW_AFTER);/* Clear flags to be sure */
             continue;                               /* Ignore hidden elements */
         }
+        if (!force_redraw && !guii_widget_getflag(h, GUI_FLAG_REDRAW | GUI_FLAG_CHILD_REDRAW)) {
+            continue;                               /* Nothing to redraw in this subtree */
+        }
+#if GUI_CFG_USE_REDRAW_SLICE
+        if (!force_redraw && redraw_slice_expired()) {
+            break;                                  /* Remaining widgets keep their flags for next slice */
+        }
+#endif /* GUI_CFG_USE_REDRAW_SLICE */
         if (guii_widget_isinsideclippingregion(h, 1)) { /* If widget is inside clipping region and not fully covered by any of its siblings */
             /* Draw main widget if required */
             if (guii_widget_getflag(h, GUI_FLAG_REDRAW) || force_redraw) {    /* Check if redraw required */
@@ -133,28 +173,36 @@ redraw_widgets(gui_handle_p parent, uint8_t force_redraw) {
                 gui_layer_t* layerPrev = GUI.lcd.drawing_layer; /* Save drawing layer */
                 uint8_t transparent = 0;
 #endif /* GUI_CFG_USE_ALPHA */
+#if GUI_CFG_USE_REDRAW_SLICE
+                uint8_t atomic = force_redraw;      /* Forced drawing can't be suspended */
+#endif /* GUI_CFG_USE_REDRAW_SLICE */
                 
-                guii_widget_clrflag(h, GUI_FLAG_REDRAW);    /* Clear flag for drawing on widget */
+                guii_widget_clrflag(h, GUI_FLAG_REDRAW | GUI_FLAG_CHILD_REDRAW | GUI_FLAG_DRAW_AFTER);  /* Clear flags, all children are redrawn too */
                 
-                /* Prepare clipping region for this widget drawing */
-                check_disp_clipping(h);             /* Check coordinates for drawings only particular widget */
+                /* Prepare clipping region for this widget and its children */
+                get_clipping_region(h, parent_clip, &clip, &children_clip);
 
 #if GUI_CFG_USE_ALPHA
                 /* Check alpha and check if blending function exists to merge layers later together */
-                if (guii_widget_hasalpha(h) /* && GUI.ll.CopyBlend != NULL */) {
-                    gui_dim_t width = GUI.display_temp.x2 - GUI.display_temp.x1;
-                    gui_dim_t height = GUI.display_temp.y2 - GUI.display_temp.y1;
+                if (guii_widget_hasalpha(h) && !guii_quality_isdegraded(GUI_QUALITY_DEGRADE_ALPHA)) {
+                    gui_dim_t width = clip.x2 - clip.x1;
+                    gui_dim_t height = clip.y2 - clip.y1;
                     
                     /* Try to allocate memory for new virtual layer for temporary usage */
-                    GUI.lcd.drawing_layer = GUI_MEMALLOC(sizeof(*GUI.lcd.drawing_layer) + (size_t)width * (size_t)height * (size_t)GUI.lcd.pixel_size);
+                    size_t size = sizeof(*GUI.lcd.drawing_layer) + (size_t)width * (size_t)height * (size_t)GUI.lcd.pixel_size;
+                    GUI.lcd.drawing_layer = gui_frame_alloc(size);
                     
                     if (GUI.lcd.drawing_layer != NULL) {/* Check if allocation was successful */
+                        memset(GUI.lcd.drawing_layer, 0x00, size);
                         GUI.lcd.drawing_layer->width = width;
                         GUI.lcd.drawing_layer->height = height;
-                        GUI.lcd.drawing_layer->x_pos = GUI.display_temp.x1;
-                        GUI.lcd.drawing_layer->y_pos = GUI.display_temp.y1;
+                        GUI.lcd.drawing_layer->x_pos = clip.x1;
+                        GUI.lcd.drawing_layer->y_pos = clip.y1;
                         GUI.lcd.drawing_layer->start_address = ((uint8_t *)GUI.lcd.drawing_layer) + sizeof(*GUI.lcd.drawing_layer);
                         transparent = 1;            /* We are going to transparent drawing mode */
+#if GUI_CFG_USE_REDRAW_SLICE
+                        atomic = 1;                 /* Virtual layer must be finished in one slice */
+#endif /* GUI_CFG_USE_REDRAW_SLICE */
                     } else {
                         GUI.lcd.drawing_layer = layerPrev;  /* Reset layer back */
                     }
@@ -162,7 +210,8 @@ redraw_widgets(gui_handle_p parent, uint8_t force_redraw) {
 #endif /* GUI_CFG_USE_ALPHA */
                 
                 /* Draw widget itself normally, don't care on layer offset and size */
-                GUI_EVT_PARAMTYPE_DISP(&GUI.evt_param) = &GUI.display_temp;
+                disp = clip;                        /* Widget may modify region during drawing */
+                GUI_EVT_PARAMTYPE_DISP(&GUI.evt_param) = &disp;
                 guii_widget_callback(h, GUI_EVT_DRAW, &GUI.evt_param, &GUI.evt_result);
                 
                 /* Check if there are children widgets in this widget */
@@ -170,17 +219,39 @@ redraw_widgets(gui_handle_p parent, uint8_t force_redraw) {
                     /* ...now call function for actual redrawing process */
                     /* Force children redraw operation, even if no redraw flag set */
                     level++;
-                    cnt += redraw_widgets(h, 1);    /* Redraw children widgets */
+#if GUI_CFG_USE_REDRAW_SLICE
+                    /*
+                     * Mark children for redraw instead of forcing them,
+                     * drawing may then be suspended between children and continued in next slice
+                     */
+                    if (!atomic) {
+                        gui_handle_p c;
+                        GUI_LINKEDLIST_WIDGETSLISTNEXT(h, c) {
+                            guii_widget_setflag(c, GUI_FLAG_REDRAW);
+                        }
+                        cnt += redraw_widgets(h, &children_clip, 0);    /* Redraw marked children widgets */
+                    } else
+#endif /* GUI_CFG_USE_REDRAW_SLICE */
+                    {
+                        cnt += redraw_widgets(h, &children_clip, 1);    /* Redraw children widgets */
+                    }
                     level--;
+                    if (children_need_redraw(h)) {  /* Some children were skipped */
+                        guii_widget_setflag(h, GUI_FLAG_CHILD_REDRAW);
+                    }
                 }
                 
-                /* TODO: Copy previous temporary variables instead of calling function again */
-                /* Prepare clipping region for this widget drawing */
-                check_disp_clipping(h);             /* Check coordinates for drawings only particular widget */
-                
-                /* Draw widget itself normally, don't care on layer offset and size */
-                GUI_EVT_PARAMTYPE_DISP(&GUI.evt_param) = &GUI.display_temp;
-                guii_widget_callback(h, GUI_EVT_DRAWAFTER, &GUI.evt_param, &GUI.evt_result);
+#if GUI_CFG_USE_REDRAW_SLICE
+                if (GUI.redraw_slice.expired) {     /* Children are not finished yet */
+                    guii_widget_setflag(h, GUI_FLAG_CHILD_REDRAW | GUI_FLAG_DRAW_AFTER);    /* Continue with children and finish widget in next slice */
+                } else
+#endif /* GUI_CFG_USE_REDRAW_SLICE */
+                {
+                    /* Restore clipping region of this widget, children used their own */
+                    disp = clip;
+                    GUI_EVT_PARAMTYPE_DISP(&GUI.evt_param) = &disp;
+                    guii_widget_callback(h, GUI_EVT_DRAWAFTER, &GUI.evt_param, &GUI.evt_result);
+                }
                 
 #if GUI_CFG_USE_ALPHA
                 /* If transparent mode is used on widget, copy content back */
@@ -222,7 +293,7 @@ redraw_widgets(gui_handle_p parent, uint8_t force_redraw) {
                         }                        
                     }
                     
-                    GUI_MEMFREE(GUI.lcd.drawing_layer); /* Free memory for virtual layer */
+                    gui_frame_free(GUI.lcd.drawing_layer);  /* Free memory for virtual layer */
                     GUI.lcd.drawing_layer = layerPrev;  /* Reset layer pointer */
                 }
 #endif /* GUI_CFG_USE_ALPHA */
@@ -230,7 +301,22 @@ redraw_widgets(gui_handle_p parent, uint8_t force_redraw) {
                 cnt++;
             /* Check if any child widget needs drawing */
             } else if (guii_widget_haschildren(h)) {
-                cnt += redraw_widgets(h, 0);        /* Redraw children widgets */
+                guii_widget_clrflag(h, GUI_FLAG_CHILD_REDRAW);  /* Clear before children may set it again */
+                get_clipping_region(h, parent_clip, &clip, &children_clip);
+                cnt += redraw_widgets(h, &children_clip, 0);    /* Redraw children widgets */
+                if (children_need_redraw(h)) {      /* Some children were skipped */
+                    guii_widget_setflag(h, GUI_FLAG_CHILD_REDRAW);
+                }
+#if GUI_CFG_USE_REDRAW_SLICE
+                if (GUI.redraw_slice.expired) {
+                    guii_widget_setflag(h, GUI_FLAG_CHILD_REDRAW);  /* Continue with children in next slice */
+                } else if (guii_widget_getflag(h, GUI_FLAG_DRAW_AFTER)) {   /* Children of suspended widget are finished */
+                    guii_widget_clrflag(h, GUI_FLAG_DRAW_AFTER);
+                    disp = clip;
+                    GUI_EVT_PARAMTYPE_DISP(&GUI.evt_param) = &disp;
+                    guii_widget_callback(h, GUI_EVT_DRAWAFTER, &GUI.evt_param, &GUI.evt_result);
+                }
+#endif /* GUI_CFG_USE_REDRAW_SLICE */
             }
         }
     }
@@ -435,11 +521,13 @@ PT_THREAD(__TouchEvents_Thread(guii_touch_data_t* const ts, gui_touch_data_t* co
  *                  position for touch and call callback function to this widget
  * \param[in]       touch: Touch data info
  * \param[in]       parent: Parent widget where to check for touch
+ * \param[in]       parent_clip: Clipping region for children of parent widget
  * \return          Member of \ref guii_touch_status_t enumeration about success
  */
 static guii_touch_status_t
-process_touch(guii_touch_data_t* const touch, gui_touch_data_t* const touch_old, gui_handle_p parent) {
+process_touch(guii_touch_data_t* const touch, gui_touch_data_t* const touch_old, gui_handle_p parent, const gui_display_t* parent_clip) {
     gui_handle_p h;
+    gui_display_t clip, children_clip;
     static uint8_t deep = 0;
     static uint8_t isKeyboard = 0;
     uint8_t dialogOnly = 0;
@@ -478,23 +566,24 @@ process_touch(guii_touch_data_t* const touch, gui_touch_data_t* const touch_old,
             isKeyboard = 1;                         /* Set keyboard mode as 1 */
         }
         
+        /* Get display region where widget and its children are placed */
+        get_clipping_region(h, parent_clip, &clip, &children_clip);
+        
         /*
          * Before we check if touch position matches widget coordinates
          * we have to check if this widget has any direct children
          */
         if (guii_widget_haschildren(h)) {           /* Check if widget has children */
             deep++;                                 /* Go deeper in level */
-            tStat = process_touch(touch, touch_old, h); /* Process touch on widget elements first */
+            tStat = process_touch(touch, touch_old, h, &children_clip); /* Process touch on widget elements first */
             deep--;                                 /* Go back to normal level */
         }
         
         /* hildren widgets were not detected */
         if (tStat == touchCONTINUE) {               /* Do we still have to check this widget? */
-            check_disp_clipping(h);                 /* Check display region where widget is placed */
-        
             /* Check if widget is in touch area */
-            if (touch->ts.x[0] >= GUI.display_temp.x1 && touch->ts.x[0] <= GUI.display_temp.x2 && 
-                touch->ts.y[0] >= GUI.display_temp.y1 && touch->ts.y[0] <= GUI.display_temp.y2) {
+            if (touch->ts.x[0] >= clip.x1 && touch->ts.x[0] <= clip.x2 && 
+                touch->ts.y[0] >= clip.y1 && touch->ts.y[0] <= clip.y2) {
                 set_relative_coordinate(touch, touch_old, h);
                     
                 /* Call touch start callback to see if widget accepts touches */
@@ -645,7 +734,9 @@ gui_process_touch(void) {
              * Action: Touch down on element, find element
              */
             if (GUI.touch.ts.status && !GUI.touch_old.status) {
-                process_touch(&GUI.touch, &GUI.touch_old, NULL);
+                gui_display_t clip;
+                get_root_clipping_region(&clip, 0); /* Touch is not limited to invalidated area */
+                process_touch(&GUI.touch, &GUI.touch_old, NULL, &clip);
                 if (GUI.active_widget != GUI.active_widget_prev) {  /* If new active widget is not the same as previous */
                     PT_INIT(&GUI.touch.pt)          /* Reset thread, otherwise process with double click event */
                 }
@@ -725,21 +816,90 @@ process_keyboard(void) {
 }
 #endif /* GUI_CFG_USE_KEYBOARD || __DOXYGEN__ */
 
+#if GUI_CFG_USE_ADAPTIVE_QUALITY || __DOXYGEN__
+
 /**
- * \brief           Process redraw of all widgets
+ * \brief           Default adaptive quality policy
+ *
+ *                  Every frame over budget degrades one more feature,
+ *                  in order of \ref GUI_FLAGS_QUALITY flags. When GUI is idle,
+ *                  last degraded feature is restored, one feature at a time
+ * \param[in]       degrade: Currently degraded features
+ * \param[in]       paint_time: Paint time of last frame in units of milliseconds
+ * \param[in]       idle: Set to `1` when GUI is idle
+ * \return          New set of degraded features
+ */
+static uint32_t
+default_quality_policy(uint32_t degrade, uint32_t paint_time, uint8_t idle) {
+    uint32_t f;
+
+    if (idle) {                                     /* Nothing to draw for long time */
+        for (f = GUI_QUALITY_DEGRADE_ALPHA; f && !(degrade & f); f >>= 1) {}   /* Find last degraded feature */
+        return degrade & ~f;                        /* Restore only this feature */
+    }
+    if (paint_time > GUI_CFG_ADAPTIVE_QUALITY_BUDGET) { /* Frame budget exceeded */
+        return ((degrade << 1) | 0x01) & GUI_QUALITY_DEGRADE_ALL;   /* Degrade next feature */
+    }
+    return degrade;
+}
+
+/**
+ * \brief           Set new degraded features
+ *
+ *                  Widgets are not invalidated, new features are used
+ *                  when widgets are redrawn next time
+ * \param[in]       degrade: New set of degraded features
  */
 static void
-process_redraw(void) {
+quality_apply(uint32_t degrade) {
+    GUI.quality.degrade = degrade & GUI_QUALITY_DEGRADE_ALL;    /* Set new features */
+}
+
+/**
+ * \brief           Call quality policy and apply its result
+ *
+ *                  When quality is degraded again by first frame after restore,
+ *                  idle time before next restore is doubled to prevent oscillation
+ * \param[in]       paint_time: Paint time of last frame in units of milliseconds
+ * \param[in]       idle: Set to `1` when GUI is idle
+ */
+static void
+quality_update(uint32_t paint_time, uint8_t idle) {
+    uint32_t degrade;
+
+    if (!idle) {
+        GUI.quality.paint_time = paint_time;        /* Save last paint time */
+    }
+    degrade = GUI.quality.policy(GUI.quality.degrade, paint_time, idle) & GUI_QUALITY_DEGRADE_ALL;
+    if (idle) {
+        GUI.quality.restored = degrade != GUI.quality.degrade;  /* Check if anything was restored */
+        GUI.quality.last_frame = gui_sys_now();     /* Wait full idle time before next step */
+    } else {
+        if (GUI.quality.restored && (degrade & ~GUI.quality.degrade)) { /* Degraded again right after restore */
+            GUI.quality.idle_time <<= 1;            /* Back off with next restore */
+            if (GUI.quality.idle_time > GUI_CFG_ADAPTIVE_QUALITY_IDLE_TIME_MAX) {
+                GUI.quality.idle_time = GUI_CFG_ADAPTIVE_QUALITY_IDLE_TIME_MAX;
+            }
+        }
+        GUI.quality.restored = 0;
+    }
+    if (!degrade) {                                 /* Full quality reached */
+        GUI.quality.idle_time = GUI_CFG_ADAPTIVE_QUALITY_IDLE_TIME;
+    }
+    quality_apply(degrade);
+}
+#endif /* GUI_CFG_USE_ADAPTIVE_QUALITY || __DOXYGEN__ */
+
+/**
+ * \brief           Copy area changed in previous frame from active layer to drawing layer
+ *
+ *                  Drawing layer must be up to date before only invalidated part of screen is drawn on it
+ */
+static void
+sync_drawing_layer(void) {
     gui_layer_t* active = GUI.lcd.active_layer;
     gui_layer_t* drawing = GUI.lcd.drawing_layer;
-    uint8_t result = 1;
     gui_display_t* dispA = &active->display;
-    
-    if ((GUI.lcd.flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM) || !(GUI.flags & GUI_FLAG_REDRAW)) {  /* Check if anything to draw first */
-        return;
-    }
-    
-    GUI.flags &= ~GUI_FLAG_REDRAW;                  /* Clear redraw flag */
 
     /* Copy from currently active layer to drawing layer only changes on layer */
     if (dispA->x1 < GUI.lcd.width && dispA->x2 >= 0 && dispA->y1 < GUI.lcd.height && dispA->y2 >= 0) {
@@ -752,13 +912,76 @@ process_redraw(void) {
             active->width - (dispA->x2 - dispA->x1) /* Offline source */
         );
     }
+}
+
+/**
+ * \brief           Draw all invalidated widgets to drawing layer
+ *
+ *                  When \ref GUI_CFG_USE_REDRAW_SLICE is enabled, drawing may be suspended
+ *                  after \ref GUI_CFG_REDRAW_SLICE_TIME and continued in next call
+ *
+ * \note            Function must be called when core protection is active
+ * \param[out]      frame: Area of screen drawn in this frame
+ * \return          `1` when frame is finished and can be shown, `0` otherwise
+ */
+static uint8_t
+draw_frame(gui_display_t* frame) {
+    gui_display_t clip;
+#if GUI_CFG_USE_ADAPTIVE_QUALITY || GUI_CFG_USE_REDRAW_SLICE
+    uint32_t time;
+#endif /* GUI_CFG_USE_ADAPTIVE_QUALITY || GUI_CFG_USE_REDRAW_SLICE */
     
-    redraw_widgets(NULL, 0);                        /* Redraw all widgets now on drawing layer */
-    drawing->pending = 1;                           /* Set drawing layer as pending */
+    GUI.flags &= ~GUI_FLAG_REDRAW;                  /* Clear redraw flag */
+
+#if GUI_CFG_USE_ADAPTIVE_QUALITY || GUI_CFG_USE_REDRAW_SLICE
+    time = gui_sys_now();                           /* Get paint start time */
+#endif /* GUI_CFG_USE_ADAPTIVE_QUALITY || GUI_CFG_USE_REDRAW_SLICE */
+#if GUI_CFG_USE_REDRAW_SLICE
+    GUI.redraw_slice.start = time;                  /* Start new slice */
+    GUI.redraw_slice.expired = 0;
+#endif /* GUI_CFG_USE_REDRAW_SLICE */
+    get_root_clipping_region(&clip, 1);             /* Drawing is limited to invalidated area */
+    redraw_widgets(NULL, &clip, 0);                 /* Redraw all widgets now on drawing layer */
+#if GUI_CFG_USE_REDRAW_SLICE
+    if (GUI.redraw_slice.expired) {                 /* Frame is not finished yet */
+        GUI.redraw_slice.in_progress = 1;
+        GUI.redraw_slice.paint_time += gui_sys_now() - time;
+        GUI.flags |= GUI_FLAG_REDRAW;               /* Continue drawing in next call */
+        return 0;
+    }
+    time -= GUI.redraw_slice.paint_time;            /* Include time of previous slices */
+    GUI.redraw_slice.paint_time = 0;
+    GUI.redraw_slice.in_progress = 0;
+#endif /* GUI_CFG_USE_REDRAW_SLICE */
+    GUI.lcd.drawing_layer->pending = 1;             /* Set drawing layer as pending */
 
     /* Draw clipping area rectangle on screen for debug */
     //gui_draw_rectangle(&GUI.display, GUI.display.x1, GUI.display.y1, GUI.display.x2, GUI.display.y2, GUI_COLOR_RED);
     
+    memcpy(frame, &GUI.display, sizeof(*frame));    /* Save area drawn in this frame */
+    
+    /* Invalid clipping region(s) for next drawing process */
+    GUI.display.x1 = GUI_DIM_MAX;
+    GUI.display.y1 = GUI_DIM_MAX;
+    GUI.display.x2 = GUI_DIM_MIN;
+    GUI.display.y2 = GUI_DIM_MIN;
+#if GUI_CFG_USE_ADAPTIVE_QUALITY
+    GUI.quality.last_frame = gui_sys_now();         /* Save frame end time */
+    quality_update(GUI.quality.last_frame - time, 0);   /* Check frame budget */
+#endif /* GUI_CFG_USE_ADAPTIVE_QUALITY */
+    return 1;
+}
+
+/**
+ * \brief           Show drawing layer on screen and swap layers
+ * \param[in]       frame: Area of screen drawn in this frame
+ */
+static void
+present_frame(const gui_display_t* frame) {
+    gui_layer_t* active = GUI.lcd.active_layer;
+    gui_layer_t* drawing = GUI.lcd.drawing_layer;
+    uint8_t result = 1;
+
     /* Notify low-level about layer change */
     GUI.lcd.flags |= GUI_FLAG_LCD_WAIT_LAYER_CONFIRM;
     gui_ll_control(&GUI.lcd, GUI_LL_Command_SetActiveLayer, &drawing, &result); /* Set new active layer to low-level driver */
@@ -768,13 +991,32 @@ process_redraw(void) {
     GUI.lcd.active_layer = drawing;
     GUI.lcd.drawing_layer = active;
     
-    memcpy(&GUI.lcd.active_layer->display, &GUI.display, sizeof(GUI.display));  /* Copy clipping data to region */
+    memcpy(&GUI.lcd.active_layer->display, frame, sizeof(*frame));  /* Copy clipping data to region */
+}
+
+/**
+ * \brief           Process redraw of all widgets
+ */
+static void
+process_redraw(void) {
+    gui_display_t frame;
+    uint8_t done;
     
-    /* Invalid clipping region(s) for next drawing process */
-    GUI.display.x1 = GUI_DIM_MAX;
-    GUI.display.y1 = GUI_DIM_MAX;
-    GUI.display.x2 = GUI_DIM_MIN;
-    GUI.display.y2 = GUI_DIM_MIN;
+    if ((GUI.lcd.flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM) || !(GUI.flags & GUI_FLAG_REDRAW)) {  /* Check if anything to draw first */
+        return;
+    }
+    
+#if GUI_CFG_USE_REDRAW_SLICE
+    if (!GUI.redraw_slice.in_progress)              /* Layer is already prepared for suspended frame */
+#endif /* GUI_CFG_USE_REDRAW_SLICE */
+    {
+        sync_drawing_layer();                       /* Prepare drawing layer */
+    }
+    done = draw_frame(&frame);                      /* Draw invalidated widgets */
+    guii_frame_reset();                             /* Release transient drawing memory */
+    if (done) {
+        present_frame(&frame);                      /* Show new frame when finished */
+    }
 }
 
 /**
@@ -814,6 +1056,10 @@ gui_init(void) {
     memset((void *)&GUI, 0x00, sizeof(GUI));        /* Reset GUI structure */
     
     gui_seteventcallback(NULL);                     /* Set event callback */
+#if GUI_CFG_USE_ADAPTIVE_QUALITY
+    gui_quality_setpolicy(NULL);                    /* Set default quality policy */
+    GUI.quality.idle_time = GUI_CFG_ADAPTIVE_QUALITY_IDLE_TIME;
+#endif /* GUI_CFG_USE_ADAPTIVE_QUALITY */
     
 #if GUI_CFG_OS
     /* Init system */
@@ -879,6 +1125,11 @@ gui_process(void) {
     uint32_t time;
     uint32_t tmr_cnt = guii_timer_getactivecount(); /* Get number of active timers in system */
     
+#if GUI_CFG_USE_REDRAW_SLICE
+    if (GUI.redraw_slice.in_progress) {             /* Suspended frame should continue as soon as possible */
+        tmr_cnt = 1;
+    }
+#endif /* GUI_CFG_USE_REDRAW_SLICE */
     time = gui_sys_mbox_get(&GUI.OS.mbox, (void **)&msg, tmr_cnt ? 1 : 20); /* Get value from message queue */
     
     GUI_UNUSED(time);
@@ -888,6 +1139,7 @@ gui_process(void) {
     GUI_CORE_PROTECT(1);
     guii_timer_process();                           /* Process all timers */
     guii_widget_executeremove();                    /* Delete widgets */
+    guii_graph_process();                           /* Update graphs after writes to user data arrays */
 #if GUI_CFG_USE_TOUCH
     gui_process_touch();                            /* Process touch inputs */
 #endif /* GUI_CFG_USE_TOUCH */
@@ -895,6 +1147,13 @@ gui_process(void) {
     process_keyboard();                             /* Process keyboard inputs */
 #endif /* GUI_CFG_USE_KEYBOARD */
     process_redraw();                               /* Redraw widgets */
+#if GUI_CFG_USE_ADAPTIVE_QUALITY
+    /* Restore quality when there was nothing to draw for some time */
+    if (GUI.quality.degrade && !(GUI.flags & GUI_FLAG_REDRAW)
+        && (gui_sys_now() - GUI.quality.last_frame) > GUI.quality.idle_time) {
+        quality_update(0, 1);
+    }
+#endif /* GUI_CFG_USE_ADAPTIVE_QUALITY */
     GUI_CORE_UNPROTECT(1);
     
     return 0;                                       /* Return number of elements updated on GUI */
@@ -915,6 +1174,62 @@ gui_seteventcallback(gui_eventcallback_t cb) {
     return 1;
 }
 
+#if GUI_CFG_USE_ADAPTIVE_QUALITY || __DOXYGEN__
+
+/**
+ * \brief           Set adaptive quality policy function
+ *
+ *                  Policy is called after every drawn frame with measured paint time
+ *                  and when GUI is idle while any feature is degraded
+ * \param[in]       policy: Policy function. Set to `NULL` to use default policy
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_quality_setpolicy(gui_quality_policy_fn policy) {
+    if (policy != NULL) {
+        GUI.quality.policy = policy;                /* Set user policy */
+    } else {
+        GUI.quality.policy = default_quality_policy;/* Set default policy */
+    }
+    return 1;
+}
+
+/**
+ * \brief           Manually set degraded drawing features
+ * \note            Widgets are not invalidated, new features are used when widgets are redrawn
+ * \note            Policy function may change features again after next frame
+ * \param[in]       degrade: Degraded features, combination of \ref GUI_FLAGS_QUALITY flags.
+ *                      Set to `0` to restore full quality
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_quality_setdegrade(uint32_t degrade) {
+    GUI_CORE_PROTECT(1);
+    quality_apply(degrade);                         /* Apply new features */
+    GUI_CORE_UNPROTECT(1);
+    return 1;
+}
+
+/**
+ * \brief           Get currently degraded drawing features
+ * \return          Combination of \ref GUI_FLAGS_QUALITY flags
+ */
+uint32_t
+gui_quality_getdegrade(void) {
+    return GUI.quality.degrade;
+}
+
+/**
+ * \brief           Get paint time of last drawn frame
+ * \return          Paint time in units of milliseconds
+ */
+uint32_t
+gui_quality_getpainttime(void) {
+    return GUI.quality.paint_time;
+}
+
+#endif /* GUI_CFG_USE_ADAPTIVE_QUALITY || __DOXYGEN__ */
+
 #if GUI_CFG_OS || __DOXYGEN__
 
 /**
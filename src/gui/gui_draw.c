@@ -390,7 +390,11 @@ draw_char(const gui_display_t* disp, const gui_font_t* font, const gui_draw_text
                         baseColor = draw->color2;
                     }
                     tmp = (b >> (6 - 2 * k)) & 0x03;/* Get temporary bits on bottom */
-                    if (tmp == 0x03) {              /* Draw solid color if both bits are enabled */
+                    if (guii_quality_isdegraded(GUI_QUALITY_DEGRADE_TEXT_AA)) { /* No blending in degraded quality */
+                        if (tmp & 0x02) {           /* Use pixel as 1-bit value */
+                            gui_draw_setpixel(disp, x1, y, baseColor);
+                        }
+                    } else if (tmp == 0x03) {       /* Draw solid color if both bits are enabled */
                         gui_draw_setpixel(disp, x1, y, baseColor);
                     } else if (tmp) {               /* Calculate new color */
                         float t = (float)tmp / 3.0f;
@@ -499,6 +503,108 @@ gui_draw_fill(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t wid
     }
 }
 
+/* Draw horizontal span between x1 and x2 (both inclusive), clipped to display region */
+static void
+draw_span(const gui_display_t* disp, gui_dim_t x1, gui_dim_t x2, gui_dim_t y, gui_color_t color) {
+    if (y < disp->y1 || y >= disp->y2) {
+        return;
+    }
+    if (x1 < disp->x1) {
+        x1 = disp->x1;
+    }
+    if (x2 >= disp->x2) {
+        x2 = disp->x2 - 1;
+    }
+    if (x2 >= x1) {
+        GUI.ll.DrawHLine(&GUI.lcd, GUI.lcd.drawing_layer, x1 - GUI.lcd.drawing_layer->x_pos, y - GUI.lcd.drawing_layer->y_pos, x2 - x1 + 1, color);
+    }
+}
+
+/* Draw vertical span between y1 and y2 (both inclusive), clipped to display region */
+static void
+draw_vspan(const gui_display_t* disp, gui_dim_t x, gui_dim_t y1, gui_dim_t y2, gui_color_t color) {
+    if (x < disp->x1 || x >= disp->x2) {
+        return;
+    }
+    if (y1 < disp->y1) {
+        y1 = disp->y1;
+    }
+    if (y2 >= disp->y2) {
+        y2 = disp->y2 - 1;
+    }
+    if (y2 >= y1) {
+        GUI.ll.DrawVLine(&GUI.lcd, GUI.lcd.drawing_layer, x - GUI.lcd.drawing_layer->x_pos, y1 - GUI.lcd.drawing_layer->y_pos, y2 - y1 + 1, color);
+    }
+}
+
+/* Get X position of edge from (xa, ya) to (xb, yb) at Y position, ya and yb must be different */
+static gui_dim_t
+edge_x(gui_dim_t xa, gui_dim_t ya, gui_dim_t xb, gui_dim_t yb, gui_dim_t y) {
+    return xa + (gui_dim_t)(((int32_t)(xb - xa) * (int32_t)(y - ya)) / (int32_t)(yb - ya));
+}
+
+/*
+ * Get pixels of line from (xa, ya) to (xb, yb) on line Y, as drawn by line rasterizer.
+ * Pixels form single run from lo to hi (both inclusive), function returns 0 when line does not cross Y.
+ * Fill functions extend their spans to these pixels so that filled shape covers its outline
+ */
+static uint8_t
+line_row_run(gui_dim_t xa, gui_dim_t ya, gui_dim_t xb, gui_dim_t yb, gui_dim_t y, gui_dim_t* lo, gui_dim_t* hi) {
+    int32_t dx, dy, m, i0, i1;
+    gui_dim_t x0, x1;
+    
+    dx = GUI_ABS(xb - xa);
+    dy = GUI_ABS(yb - ya);
+    m = yb >= ya ? y - ya : ya - y;                 /* Offset of line Y from start point */
+    if (m < 0 || m > dy) {
+        return 0;
+    }
+    if (dx >= dy) {                                 /* X is major axis, run of pixels on line */
+        if (dy == 0) {
+            i0 = 0;
+            i1 = dx;
+        } else {
+            i0 = (int32_t)(((int64_t)m * dx - dx / 2 + dy - 1) / dy);
+            i1 = (int32_t)(((int64_t)(m + 1) * dx - dx / 2 - 1) / dy);
+            i0 = GUI_MAX(i0, 0);
+            i1 = GUI_MIN(i1, dx);
+        }
+        x0 = xa + (xb >= xa ? i0 : -i0);
+        x1 = xa + (xb >= xa ? i1 : -i1);
+    } else {                                        /* Y is major axis, single pixel on line */
+        i0 = (int32_t)(((int64_t)dy / 2 + (int64_t)dx * m) / dy);
+        x0 = x1 = xa + (xb >= xa ? i0 : -i0);
+    }
+    *lo = GUI_MIN(x0, x1);
+    *hi = GUI_MAX(x0, x1);
+    return 1;
+}
+
+/* Insert span to array of spans sorted by start position */
+static void
+span_insert(gui_dim_t* spans, size_t* cnt, gui_dim_t lo, gui_dim_t hi) {
+    size_t i;
+    
+    for (i = *cnt; i > 0 && spans[2 * (i - 1)] > lo; i--) {
+        spans[2 * i] = spans[2 * (i - 1)];
+        spans[2 * i + 1] = spans[2 * (i - 1) + 1];
+    }
+    spans[2 * i] = lo;
+    spans[2 * i + 1] = hi;
+    (*cnt)++;
+}
+
+/* Extend span from lo to hi with pixels of line on line Y */
+static void
+span_add_line(gui_dim_t xa, gui_dim_t ya, gui_dim_t xb, gui_dim_t yb, gui_dim_t y, gui_dim_t* lo, gui_dim_t* hi) {
+    gui_dim_t l, h;
+    
+    if (line_row_run(xa, ya, xb, yb, y, &l, &h)) {
+        *lo = GUI_MIN(*lo, l);
+        *hi = GUI_MAX(*hi, h);
+    }
+}
+
 /**
  * \brief           Initialize \ref gui_draw_text_t structure for further usage
  * \param[in,out]   f: Pointer to empty \ref gui_draw_text_t structure 
@@ -595,37 +701,337 @@ gui_draw_hline(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t le
     GUI.ll.DrawHLine(&GUI.lcd, GUI.lcd.drawing_layer, x - GUI.lcd.drawing_layer->x_pos, y - GUI.lcd.drawing_layer->y_pos, length, color);
 }
 
+/*
+ * Draw outline runs of circle corners
+ *
+ * Pixels with offsets xs..xe from origin at distance y form horizontal span,
+ * mirrored pixels form vertical span at distance y
+ */
+static void
+circle_runs(const gui_display_t* disp, gui_dim_t x0, gui_dim_t y0, gui_dim_t xs, gui_dim_t xe, gui_dim_t y, uint8_t c, gui_color_t color) {
+    if (c & GUI_DRAW_CIRCLE_TL) {                   /* Top left corner */
+        draw_span(disp, x0 - xe, x0 - xs, y0 - y, color);
+        draw_vspan(disp, x0 - y, y0 - xe, y0 - xs, color);
+    }
+    if (c & GUI_DRAW_CIRCLE_TR) {                   /* Top right corner */
+        draw_span(disp, x0 + xs, x0 + xe, y0 - y, color);
+        draw_vspan(disp, x0 + y, y0 - xe, y0 - xs, color);
+    }
+    if (c & GUI_DRAW_CIRCLE_BR) {                   /* Bottom right corner */
+        draw_span(disp, x0 + xs, x0 + xe, y0 + y, color);
+        draw_vspan(disp, x0 + y, y0 + xs, y0 + xe, color);
+    }
+    if (c & GUI_DRAW_CIRCLE_BL) {                   /* Bottom left corner */
+        draw_span(disp, x0 - xe, x0 - xs, y0 + y, color);
+        draw_vspan(disp, x0 - y, y0 + xs, y0 + xe, color);
+    }
+}
+
+/*
+ * Draw filled runs of circle corners
+ *
+ * Line at distance y is filled up to offset xe,
+ * lines at distances xs..xe have the same width y and are filled with single rectangle.
+ * Left and right corners on the same side are merged together
+ */
+static void
+filledcircle_runs(const gui_display_t* disp, gui_dim_t x0, gui_dim_t y0, gui_dim_t xs, gui_dim_t xe, gui_dim_t y, uint8_t c, gui_color_t color) {
+    gui_dim_t n = xe - xs + 1;
+    
+    if ((c & (GUI_DRAW_CIRCLE_TL | GUI_DRAW_CIRCLE_TR)) == (GUI_DRAW_CIRCLE_TL | GUI_DRAW_CIRCLE_TR)) {
+        draw_span(disp, x0 - xe, x0 + xe - 1, y0 - y, color);
+        gui_draw_fill(disp, x0 - y, y0 - xe, 2 * y, n, color);
+    } else if (c & GUI_DRAW_CIRCLE_TL) {            /* Top left */
+        draw_span(disp, x0 - xe, x0 - 1, y0 - y, color);
+        gui_draw_fill(disp, x0 - y, y0 - xe, y, n, color);
+    } else if (c & GUI_DRAW_CIRCLE_TR) {            /* Top right */
+        draw_span(disp, x0, x0 + xe - 1, y0 - y, color);
+        gui_draw_fill(disp, x0, y0 - xe, y, n, color);
+    }
+    if ((c & (GUI_DRAW_CIRCLE_BL | GUI_DRAW_CIRCLE_BR)) == (GUI_DRAW_CIRCLE_BL | GUI_DRAW_CIRCLE_BR)) {
+        draw_span(disp, x0 - xe, x0 + xe - 1, y0 + y, color);
+        gui_draw_fill(disp, x0 - y, y0 + xs, 2 * y, n, color);
+    } else if (c & GUI_DRAW_CIRCLE_BL) {            /* Bottom left */
+        draw_span(disp, x0 - xe, x0 - 1, y0 + y, color);
+        gui_draw_fill(disp, x0 - y, y0 + xs, y, n, color);
+    } else if (c & GUI_DRAW_CIRCLE_BR) {            /* Bottom right */
+        draw_span(disp, x0, x0 + xe - 1, y0 + y, color);
+        gui_draw_fill(disp, x0, y0 + xs, y, n, color);
+    }
+}
+
+/*
+ * Process circle corners with midpoint algorithm
+ *
+ * Instead of single pixels, runs of pixels with the same distance
+ * from origin are collected and drawn at once
+ */
+static void
+circle_corner(const gui_display_t* disp, gui_dim_t x0, gui_dim_t y0, gui_dim_t r, uint8_t c, uint8_t filled, gui_color_t color) {
+    gui_dim_t f = 1 - r;
+    gui_dim_t ddF_x = 1;
+    gui_dim_t ddF_y = -2 * r;
+    gui_dim_t x = 0;
+    gui_dim_t y = r;
+    gui_dim_t xs = 0;                               /* Start offset of current run, 0 when no run */
+    
+    while (x < y) {
+        if (f >= 0) {
+            if (xs) {                               /* Distance changes, draw finished run */
+                if (filled) {
+                    filledcircle_runs(disp, x0, y0, xs, x, y, c, color);
+                } else {
+                    circle_runs(disp, x0, y0, xs, x, y, c, color);
+                }
+                xs = 0;
+            }
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        if (!xs) {
+            xs = x;                                 /* Start new run */
+        }
+    }
+    if (xs) {                                       /* Draw last run */
+        if (filled) {
+            filledcircle_runs(disp, x0, y0, xs, x, y, c, color);
+        } else {
+            circle_runs(disp, x0, y0, xs, x, y, c, color);
+        }
+    }
+}
+
+#if GUI_CFG_USE_CIRCLE_AA || __DOXYGEN__
+
+/* Integer square root */
+static uint32_t
+isqrt(uint32_t v) {
+    uint32_t res = 0, bit = (uint32_t)1 << 30;
+    
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+/* Blend pixel with background, alpha is coverage of pixel from 0 to 255 */
+static void
+blend_pixel(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_color_t color, uint32_t alpha) {
+    gui_color_t bg;
+    uint32_t r, g, b;
+    
+    if (!alpha || y < disp->y1 || y >= disp->y2 || x < disp->x1 || x >= disp->x2) {
+        return;
+    }
+    bg = gui_draw_getpixel(disp, x, y);             /* Read current color */
+    r = (((color >> 16) & 0xFF) * alpha + ((bg >> 16) & 0xFF) * (0xFF - alpha)) / 0xFF;
+    g = (((color >>  8) & 0xFF) * alpha + ((bg >>  8) & 0xFF) * (0xFF - alpha)) / 0xFF;
+    b = (((color >>  0) & 0xFF) * alpha + ((bg >>  0) & 0xFF) * (0xFF - alpha)) / 0xFF;
+    gui_draw_setpixel(disp, x, y, (bg & 0xFF000000UL) | r << 16 | g << 8 | b);
+}
+
+/*
+ * Draw filled circle corners with anti-aliased edge
+ *
+ * For every distance i from origin, edge position is calculated in units of 1/16 pixel.
+ * Line at distance i is filled with solid span. Edge pixel is blended by its coverage
+ * on line at distance i where edge is steep and on column at distance i where edge is flat
+ */
+static void
+filledcircle_corner_aa(const gui_display_t* disp, gui_dim_t x0, gui_dim_t y0, gui_dim_t r, uint8_t c, gui_color_t color) {
+    gui_dim_t i, w;
+    uint32_t r2 = (uint32_t)r * (uint32_t)r, e, a;
+    
+    for (i = 1; i <= r; i++) {
+        e = isqrt((r2 - (uint32_t)i * (uint32_t)i) << 8);   /* Edge distance in units of 1/16 pixel */
+        w = (gui_dim_t)(e >> 4);                    /* Number of fully covered pixels */
+        a = (e & 0x0F) * 0x11;                      /* Coverage of edge pixel */
+        
+        if (c & GUI_DRAW_CIRCLE_TL) {               /* Top left */
+            draw_span(disp, x0 - w, x0 - 1, y0 - i, color);
+            if (w >= i) {                           /* Edge crosses line */
+                blend_pixel(disp, x0 - w - 1, y0 - i, color, a);
+            }
+            if (w > i) {                            /* Edge crosses column */
+                blend_pixel(disp, x0 - i, y0 - w - 1, color, a);
+            }
+        }
+        if (c & GUI_DRAW_CIRCLE_TR) {               /* Top right */
+            draw_span(disp, x0, x0 + w - 1, y0 - i, color);
+            if (w >= i) {                           /* Edge crosses line */
+                blend_pixel(disp, x0 + w, y0 - i, color, a);
+            }
+            if (w > i) {                            /* Edge crosses column */
+                blend_pixel(disp, x0 + i - 1, y0 - w - 1, color, a);
+            }
+        }
+        if (c & GUI_DRAW_CIRCLE_BL) {               /* Bottom left */
+            draw_span(disp, x0 - w, x0 - 1, y0 + i, color);
+            if (w >= i) {                           /* Edge crosses line */
+                blend_pixel(disp, x0 - w - 1, y0 + i, color, a);
+            }
+            if (w > i) {                            /* Edge crosses column */
+                blend_pixel(disp, x0 - i, y0 + w + 1, color, a);
+            }
+        }
+        if (c & GUI_DRAW_CIRCLE_BR) {               /* Bottom right */
+            draw_span(disp, x0, x0 + w - 1, y0 + i, color);
+            if (w >= i) {                           /* Edge crosses line */
+                blend_pixel(disp, x0 + w, y0 + i, color, a);
+            }
+            if (w > i) {                            /* Edge crosses column */
+                blend_pixel(disp, x0 + i - 1, y0 + w + 1, color, a);
+            }
+        }
+    }
+}
+
+#endif /* GUI_CFG_USE_CIRCLE_AA || __DOXYGEN__ */
+
 /******************************************************************************/
 /******************************************************************************/
 /***                          Functions for primitives                       **/
 /******************************************************************************/
 /******************************************************************************/
 
+#define LINE_SKIP_FIRST     0x01                    /* Do not draw first pixel of line */
+#define LINE_SKIP_LAST      0x02                    /* Do not draw last pixel of line */
+
+/*
+ * Draw line with Bresenham algorithm, both end points included unless skipped.
+ * Pixels are calculated only for part of line inside drawing region,
+ * unless caller already checked that whole line is inside region and sets clip to 0
+ */
+static void
+line_raster(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2, uint8_t skip, uint8_t clip, gui_color_t color) {
+    int32_t deltax, deltay, den, num, numadd, numpixels;
+    int32_t a, b, ainc, binc, amin, amax, mlo, mhi, i, i0, i1, run;
+    uint8_t xmajor;
+    
+    deltax = GUI_ABS(x2 - x1);
+    deltay = GUI_ABS(y2 - y1);
+    
+    /*
+     * Work with major axis (a) and minor axis (b)
+     *
+     * Pixel at step i is at major offset i and
+     * minor offset (den / 2 + numadd * i) / den from start point
+     */
+    xmajor = deltax >= deltay;
+    if (xmajor) {
+        a = x1; ainc = x2 >= x1 ? 1 : -1;
+        b = y1; binc = y2 >= y1 ? 1 : -1;
+        den = deltax; numadd = deltay;
+        amin = disp->x1; amax = disp->x2 - 1;
+        mlo = binc > 0 ? disp->y1 - b : b - (disp->y2 - 1);
+        mhi = binc > 0 ? disp->y2 - 1 - b : b - disp->y1;
+    } else {
+        a = y1; ainc = y2 >= y1 ? 1 : -1;
+        b = x1; binc = x2 >= x1 ? 1 : -1;
+        den = deltay; numadd = deltax;
+        amin = disp->y1; amax = disp->y2 - 1;
+        mlo = binc > 0 ? disp->x1 - b : b - (disp->x2 - 1);
+        mhi = binc > 0 ? disp->x2 - 1 - b : b - disp->x1;
+    }
+    numpixels = den;
+    num = den / 2;
+    i0 = (skip & LINE_SKIP_FIRST) ? 1 : 0;
+    i1 = (skip & LINE_SKIP_LAST) ? numpixels - 1 : numpixels;
+    
+    if (clip) {
+        /* Range of steps where major axis is inside region */
+        i = ainc > 0 ? amin - a : a - amax;
+        i0 = GUI_MAX(i0, i);
+        i = ainc > 0 ? amax - a : a - amin;
+        i1 = GUI_MIN(i1, i);
+        
+        /* Limit range of steps where minor axis is inside region */
+        mlo = GUI_MAX(mlo, 0);
+        mhi = GUI_MIN(mhi, numadd);
+        if (mlo > mhi) {
+            return;
+        }
+        if (mlo > 0) {                              /* First step with minor offset mlo */
+            i = (int32_t)(((int64_t)mlo * den - num + numadd - 1) / numadd);
+            i0 = GUI_MAX(i0, i);
+        }
+        if (mhi < numadd) {                         /* Last step with minor offset mhi */
+            i = (int32_t)(((int64_t)(mhi + 1) * den - num - 1) / numadd);
+            i1 = GUI_MIN(i1, i);
+        }
+    }
+    if (i0 > i1) {
+        return;
+    }
+    
+    /* Go to first visible pixel */
+    if (i0) {
+        int64_t n = (int64_t)num + (int64_t)numadd * i0;
+        b += binc * (int32_t)(n / den);
+        num = (int32_t)(n % den);
+        a += ainc * i0;
+    }
+    
+    /* Draw runs of pixels with the same minor coordinate */
+    run = a;
+    for (i = i0; i <= i1; i++) {
+        num += numadd;
+        if (num >= den || i == i1) {                /* Minor coordinate changes or last pixel */
+            if (xmajor) {
+                draw_span(disp, GUI_MIN(run, a), GUI_MAX(run, a), b, color);
+            } else {
+                draw_vspan(disp, b, GUI_MIN(run, a), GUI_MAX(run, a), color);
+            }
+            if (num >= den) {
+                num -= den;
+                b += binc;
+            }
+            run = a + ainc;
+        }
+        a += ainc;
+    }
+}
+
 /**
  * \brief           Draw line from point 1 to point 2
+ *
+ *                  Line is clipped to display region before rasterization,
+ *                  only visible part is processed. Pixels on the same line (or column for steep lines)
+ *                  are drawn together as single horizontal (or vertical) span
+ *
  * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
  * \param[in]       x1: Line start X position
  * \param[in]       y1: Line start Y position
  * \param[in]       x2: Line end X position
  * \param[in]       y2: Line end Y position
  * \param[in]       color: Color used for drawing operation
- * \sa              gui_draw_vline, gui_draw_hline
+ * \sa              gui_draw_vline, gui_draw_hline, gui_draw_polyline
  */
 void
 gui_draw_line(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2, gui_color_t color) {
-    gui_dim_t deltax = 0, deltay = 0, x = 0, y = 0, xinc1 = 0, xinc2 = 0, 
-    yinc1 = 0, yinc2 = 0, den = 0, num = 0, numadd = 0, numpixels = 0, 
-    curpixel = 0;
+    gui_dim_t deltax, deltay;
     
-    /* Check if coordinates are inside drawing region */
-//    if (                                            /* Check if redraw is inside area */
-//        !GUI_RECT_MATCH(  x1, y1, x2, y2,
-//                            disp->x1, disp->y1, disp->x2, disp->y2)) {
-//        return;
-//    }
-
-	deltax = GUI_ABS(x2 - x1);
-	deltay = GUI_ABS(y2 - y1);
+    /* Check if line bounding box is inside drawing region */
+    if (GUI_MAX(x1, x2) < disp->x1 || GUI_MIN(x1, x2) >= disp->x2
+        || GUI_MAX(y1, y2) < disp->y1 || GUI_MIN(y1, y2) >= disp->y2) {
+        return;
+    }
+
+    deltax = GUI_ABS(x2 - x1);
+    deltay = GUI_ABS(y2 - y1);
     
     if (deltax == 0) {                              /* Straight vertical line */
         gui_draw_vline(disp, x1, GUI_MIN(y1, y2), deltay, color);
@@ -635,53 +1041,61 @@ gui_draw_line(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1, gui_dim_t x
         gui_draw_hline(disp, GUI_MIN(x1, x2), y1, deltax, color);
         return;
     }
+    line_raster(disp, x1, y1, x2, y2, 0, 1, color);
+}
 
-    x = x1;
-    y = y1;
-
-    if (x2 >= x1) {
-        xinc1 = 1;
-        xinc2 = 1;
-    } else {
-        xinc1 = -1;
-        xinc2 = -1;
+/*
+ * Draw lines between points, optionally connect last point to first one.
+ * Every pixel is drawn once, shared points are drawn only by first line.
+ * Clipping is checked once for all points and lines are clipped only when polyline crosses region border
+ */
+static void
+polyline_draw(const gui_display_t* disp, const gui_draw_poly_t* points, size_t len, uint8_t closed, gui_color_t color) {
+    gui_dim_t x1, y1, x2, y2;
+    uint8_t clip;
+    size_t i;
+    
+    if (len < 2) {
+        return;
     }
-
-    if (y2 >= y1) {
-        yinc1 = 1;
-        yinc2 = 1;
-    } else {
-        yinc1 = -1;
-        yinc2 = -1;
+    
+    /* Get bounding box of all points */
+    x1 = x2 = points[0].x;
+    y1 = y2 = points[0].y;
+    for (i = 1; i < len; i++) {
+        x1 = GUI_MIN(x1, points[i].x);
+        x2 = GUI_MAX(x2, points[i].x);
+        y1 = GUI_MIN(y1, points[i].y);
+        y2 = GUI_MAX(y2, points[i].y);
     }
-
-    if (deltax >= deltay) {
-        xinc1 = 0;
-        yinc2 = 0;
-        den = deltax;
-        num = deltax / 2;
-        numadd = deltay;
-        numpixels = deltax;
-    } else {
-        xinc2 = 0;
-        yinc1 = 0;
-        den = deltay;
-        num = deltay / 2;
-        numadd = deltax;
-        numpixels = deltay;
+    if (x2 < disp->x1 || x1 >= disp->x2 || y2 < disp->y1 || y1 >= disp->y2) {
+        return;                                     /* Fully outside drawing region */
     }
-
-    for (curpixel = 0; curpixel <= numpixels; curpixel++) {
-        gui_draw_setpixel(disp, x, y, color);
-        num += numadd;
-        if (num >= den) {
-            num -= den;
-            x += xinc1;
-            y += yinc1;
-        }
-        x += xinc2;
-        y += yinc2;
+    clip = x1 < disp->x1 || x2 >= disp->x2 || y1 < disp->y1 || y2 >= disp->y2;
+    
+    for (i = 1; i < len; i++) {
+        line_raster(disp, points[i - 1].x, points[i - 1].y, points[i].x, points[i].y, i > 1 ? LINE_SKIP_FIRST : 0, clip, color);
     }
+    if (closed && len > 2) {                        /* Both points of closing line are already drawn */
+        line_raster(disp, points[0].x, points[0].y, points[len - 1].x, points[len - 1].y, LINE_SKIP_FIRST | LINE_SKIP_LAST, clip, color);
+    }
+}
+
+/**
+ * \brief           Draw lines between points
+ *
+ *                  Unlike \ref gui_draw_poly, last point is not connected to first one.
+ *                  Points shared by two lines are drawn only once
+ *
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       points: Pointer to array of \ref gui_draw_poly_t points to draw lines between
+ * \param[in]       len: Number of points in array. There must be at least 2 points
+ * \param[in]       color: Color used for drawing operation
+ * \sa              gui_draw_line, gui_draw_poly
+ */
+void
+gui_draw_polyline(const gui_display_t* disp, const gui_draw_poly_t* points, size_t len, gui_color_t color) {
+    polyline_draw(disp, points, len, 0, color);
 }
 
 /**
@@ -861,10 +1275,9 @@ gui_draw_circle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r
  */
 void
 gui_draw_filledcircle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_color_t color) {
-    gui_draw_filledcirclecorner(disp, x, y, r, GUI_DRAW_CIRCLE_TL, color);
-    gui_draw_filledcirclecorner(disp, x, y, r, GUI_DRAW_CIRCLE_TR, color);
-    gui_draw_filledcirclecorner(disp, x, y - 1, r, GUI_DRAW_CIRCLE_BL, color);
-    gui_draw_filledcirclecorner(disp, x, y - 1, r, GUI_DRAW_CIRCLE_BR, color);
+    /* Left and right part share the same line, draw them together */
+    gui_draw_filledcirclecorner(disp, x, y, r, GUI_DRAW_CIRCLE_TL | GUI_DRAW_CIRCLE_TR, color);
+    gui_draw_filledcirclecorner(disp, x, y - 1, r, GUI_DRAW_CIRCLE_BL | GUI_DRAW_CIRCLE_BR, color);
 }
 
 /**
@@ -900,58 +1313,24 @@ gui_draw_triangle(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1,  gui_di
  */
 void
 gui_draw_filledtriangle(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2, gui_dim_t x3, gui_dim_t y3, gui_color_t color) {
-    gui_dim_t deltax = 0, deltay = 0, x = 0, y = 0, xinc1 = 0, xinc2 = 0, 
-    yinc1 = 0, yinc2 = 0, den = 0, num = 0, numadd = 0, numpixels = 0, 
-    curpixel = 0;
-
-    deltax = GUI_ABS(x2 - x1);
-    deltay = GUI_ABS(y2 - y1);
-    x = x1;
-    y = y1;
-
-    if (x2 >= x1) {
-        xinc1 = 1;
-        xinc2 = 1;
-    } else {
-        xinc1 = -1;
-        xinc2 = -1;
-    }
-
-    if (y2 >= y1) {
-        yinc1 = 1;
-        yinc2 = 1;
-    } else {
-        yinc1 = -1;
-        yinc2 = -1;
-    }
-
-    if (deltax >= deltay){
-        xinc1 = 0;
-        yinc2 = 0;
-        den = deltax;
-        num = deltax / 2;
-        numadd = deltay;
-        numpixels = deltax;
-    } else {
-        xinc2 = 0;
-        yinc1 = 0;
-        den = deltay;
-        num = deltay / 2;
-        numadd = deltax;
-        numpixels = deltay;
-    }
-
-    for (curpixel = 0; curpixel <= numpixels; curpixel++) {
-        gui_draw_line(disp, x, y, x3, y3, color);
-
-        num += numadd;
-        if (num >= den) {
-            num -= den;
-            x += xinc1;
-            y += yinc1;
+    gui_dim_t y, ys, ye, lo, hi;
+    
+    /* Process only lines inside drawing region */
+    ys = GUI_MAX(GUI_MIN(y1, GUI_MIN(y2, y3)), disp->y1);
+    ye = GUI_MIN(GUI_MAX(y1, GUI_MAX(y2, y3)), disp->y2 - 1);
+    for (y = ys; y <= ye; y++) {
+        /*
+         * Triangle is convex, line of it goes from leftmost to rightmost edge pixel.
+         * Edges are taken in the same direction as in \ref gui_draw_triangle
+         */
+        lo = GUI_DIM_MAX;
+        hi = GUI_DIM_MIN;
+        span_add_line(x1, y1, x2, y2, y, &lo, &hi);
+        span_add_line(x1, y1, x3, y3, y, &lo, &hi);
+        span_add_line(x2, y2, x3, y3, y, &lo, &hi);
+        if (lo <= hi) {
+            draw_span(disp, lo, hi, y, color);
         }
-        x += xinc2;
-        y += yinc2;
     }
 }
 
@@ -971,49 +1350,13 @@ gui_draw_filledtriangle(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1, g
  */
 void
 gui_draw_circlecorner(const gui_display_t* disp, gui_dim_t x0, gui_dim_t y0, gui_dim_t r, uint8_t c, gui_color_t color) {
-    gui_dim_t f = 1 - r;
-    gui_dim_t ddF_x = 1;
-    gui_dim_t ddF_y = -2 * r;
-    gui_dim_t x = 0;
-    gui_dim_t y = r;
-    
     if (!GUI_RECT_MATCH(
         x0 - r, y0 - r, x0 + r, y0 + r,
         disp->x1, disp->y1, disp->x2, disp->y2
     )) {
         return;
     }
-
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-
-        if (c & GUI_DRAW_CIRCLE_TL) {               /* Top left corner */
-            gui_draw_setpixel(disp, x0 - y, y0 - x, color);
-            gui_draw_setpixel(disp, x0 - x, y0 - y, color);
-        }
-
-        if (c & GUI_DRAW_CIRCLE_TR) {               /* Top right corner */
-            gui_draw_setpixel(disp, x0 + x, y0 - y, color);
-            gui_draw_setpixel(disp, x0 + y, y0 - x, color);
-        }
-
-        if (c & GUI_DRAW_CIRCLE_BR) {               /* Bottom right corner */
-            gui_draw_setpixel(disp, x0 + x, y0 + y, color);
-            gui_draw_setpixel(disp, x0 + y, y0 + x, color);
-        }
-
-        if (c & GUI_DRAW_CIRCLE_BL) {               /* Bottom left corner */
-            gui_draw_setpixel(disp, x0 - x, y0 + y, color);
-            gui_draw_setpixel(disp, x0 - y, y0 + x, color);
-        }
-    }
+    circle_corner(disp, x0, y0, r, c, 0, color);    /* Draw outline runs */
 }
 
 /**
@@ -1032,46 +1375,17 @@ gui_draw_circlecorner(const gui_display_t* disp, gui_dim_t x0, gui_dim_t y0, gui
  */
 void
 gui_draw_filledcirclecorner(const gui_display_t* disp, gui_dim_t x0, gui_dim_t y0, gui_dim_t r, uint8_t c, gui_color_t color) {
-    gui_dim_t f = 1 - r;
-    gui_dim_t ddF_x = 1;
-    gui_dim_t ddF_y = -2 * r;
-    gui_dim_t x = 0;
-    gui_dim_t y = r;
-    
     if (!GUI_RECT_MATCH(
         disp->x1, disp->y1, disp->x2, disp->y2,
         x0 - r, y0 - r, x0 + r, y0 + r
     )) {
         return;
     }
-
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-
-        if (c & GUI_DRAW_CIRCLE_TL) {               /* Top left */            
-            gui_draw_hline(disp, x0 - x, y0 - y, x, color);
-            gui_draw_hline(disp, x0 - y, y0 - x, y, color);
-        }
-        if (c & GUI_DRAW_CIRCLE_TR) {               /* Top right */
-            gui_draw_hline(disp, x0, y0 - y, x, color);
-            gui_draw_hline(disp, x0, y0 - x, y, color);
-        }
-        if (c & GUI_DRAW_CIRCLE_BL) {               /* Bottom left */
-            gui_draw_hline(disp, x0 - y, y0 + x, y, color);
-            gui_draw_hline(disp, x0 - x, y0 + y, x, color);
-        }
-        if (c & GUI_DRAW_CIRCLE_BR) {               /* Bottom right */
-            gui_draw_hline(disp, x0, y0 + x, y, color);
-            gui_draw_hline(disp, x0, y0 + y, x, color);
-        }
-    }
+#if GUI_CFG_USE_CIRCLE_AA
+    filledcircle_corner_aa(disp, x0, y0, r, c, color);  /* Draw spans with anti-aliased edge */
+#else /* GUI_CFG_USE_CIRCLE_AA */
+    circle_corner(disp, x0, y0, r, c, 1, color);    /* Draw filled runs */
+#endif /* !GUI_CFG_USE_CIRCLE_AA */
 }
 
 /**
@@ -1151,23 +1465,104 @@ gui_draw_image(gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_de
  * \param[in]       points: Pointer to array of \ref gui_draw_poly_t points to draw lines between
  * \param[in]       len: Number of points in array. There must be at least 2 points
  * \param[in]       color: Color to use for drawing 
+ * \sa              gui_draw_filledpoly, gui_draw_polyline
  */
 void
 gui_draw_poly(const gui_display_t* disp, const gui_draw_poly_t* points, size_t len, gui_color_t color) {
-    gui_dim_t x = 0, y = 0;
+    polyline_draw(disp, points, len, 1, color);
+}
 
-    if (len < 2) {
+/**
+ * \brief           Draw filled polygon
+ *
+ *                  Polygon can be convex or concave and is filled using even-odd rule.
+ *                  Last point is connected to first one. Edge pixels drawn by \ref gui_draw_poly
+ *                  are always part of filled area
+ *
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       points: Pointer to array of \ref gui_draw_poly_t points of polygon
+ * \param[in]       len: Number of points in array. There must be at least 3 points
+ * \param[in]       color: Color to use for drawing 
+ * \sa              gui_draw_poly
+ */
+void
+gui_draw_filledpoly(const gui_display_t* disp, const gui_draw_poly_t* points, size_t len, gui_color_t color) {
+    gui_dim_t* nodes;
+    gui_dim_t* spans;
+    gui_dim_t y, ys, ye, x, lo, hi;
+    size_t i, j, k, cnt, scnt;
+    
+    if (len < 3) {
         return;
     }
-
-    gui_draw_line(disp, points->x, points->y, (points + len - 1)->x, (points + len - 1)->y, color);
-
-    while (--len) {
-        x = points->x;
-        y = points->y;
-        points++;
-        gui_draw_line(disp, x, y, points->x, points->y, color);
+    
+    /* Find vertical span of polygon */
+    ys = ye = points[0].y;
+    for (i = 1; i < len; i++) {
+        ys = GUI_MIN(ys, points[i].y);
+        ye = GUI_MAX(ye, points[i].y);
+    }
+    ys = GUI_MAX(ys, disp->y1);
+    ye = GUI_MIN(ye, disp->y2 - 1);
+    if (ys > ye) {                                  /* Polygon is outside drawing region */
+        return;
+    }
+    
+    /*
+     * Edge crossings for single line, there can't be more than number of edges.
+     * Spans for single line, one per pair of crossings and one per edge
+     */
+    nodes = gui_frame_alloc(sizeof(*nodes) * (len + 2 * (len / 2 + len)));
+    if (nodes == NULL) {
+        return;
     }
+    spans = &nodes[len];
+    
+    for (y = ys; y <= ye; y++) {
+        /* Find crossings of all edges with current line */
+        cnt = 0;
+        for (i = 0, j = len - 1; i < len; j = i++) {
+            if ((points[i].y <= y && points[j].y > y) || (points[j].y <= y && points[i].y > y)) {
+                x = edge_x(points[i].x, points[i].y, points[j].x, points[j].y, y);
+                
+                /* Insert sorted by X position */
+                for (k = cnt; k > 0 && nodes[k - 1] > x; k--) {
+                    nodes[k] = nodes[k - 1];
+                }
+                nodes[k] = x;
+                cnt++;
+            }
+        }
+        
+        /* Spans between pairs of crossings and edge pixels, sorted by start position */
+        scnt = 0;
+        for (k = 0; k + 1 < cnt; k += 2) {
+            span_insert(spans, &scnt, nodes[k], nodes[k + 1]);
+        }
+        if (line_row_run(points[0].x, points[0].y, points[len - 1].x, points[len - 1].y, y, &lo, &hi)) {
+            span_insert(spans, &scnt, lo, hi);      /* Closing edge in the same direction as in \ref gui_draw_poly */
+        }
+        for (i = 1; i < len; i++) {
+            if (line_row_run(points[i - 1].x, points[i - 1].y, points[i].x, points[i].y, y, &lo, &hi)) {
+                span_insert(spans, &scnt, lo, hi);
+            }
+        }
+        
+        /* Draw merged spans */
+        for (k = 0; k < scnt; k = i) {
+            lo = spans[2 * k];
+            hi = spans[2 * k + 1];
+            for (i = k + 1; i < scnt && spans[2 * i] <= hi + 1; i++) {
+                hi = GUI_MAX(hi, spans[2 * i + 1]);
+            }
+            if (lo >= disp->x2) {
+                break;                              /* Other spans are outside region too */
+            }
+            draw_span(disp, lo, hi, y, color);
+        }
+    }
+    
+    gui_frame_free(nodes);
 }
 
 /**
@@ -497,7 +497,7 @@ keyboard_base_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* co
             gui_widget_hide(h);
             gui_widget_setignoreinvalidate(h, 0, 1);
             
-            keyboard.default_font = h->font;
+            keyboard.default_font = guii_widget_ext(h)->font;
             
             /***************************/
             /* Create keyboard layouts */
@@ -569,7 +569,7 @@ gui_keyboard_hide(void) {
 
     if (keyboard.handle != NULL) {
         gui_widget_hide(keyboard.handle);           /* Hide keyboard widget */
-        gui_widget_show(GUI.root.first);            /* Show first on linked list */
+        gui_widget_show(gui_linkedlist_widgetgetnext(NULL, NULL)); /* Show first on linked list */
         ret = 1;
     }
 
@@ -587,11 +587,11 @@ gui_keyboard_show(gui_handle_p h) {
 
     if (keyboard.handle != NULL) {
         keyboard.target = h;                        /* Save target widget */
-        if (h != NULL && h->font != NULL) {         /* Check widget and font for it */
-            keyboard.font = h->font;                /* Save font as display font */
+        if (h != NULL && guii_widget_ext(h)->font != NULL) { /* Check widget and font for it */
+            keyboard.font = guii_widget_ext(h)->font; /* Save font as display font */
             gui_widget_invalidate(keyboard.handle); /* Force invalidation */
         }
-        gui_widget_hide(GUI.root.first);            /* Hide first on linked list */
+        gui_widget_hide(gui_linkedlist_widgetgetnext(NULL, NULL)); /* Hide first on linked list */
         gui_widget_show(keyboard.handle);           /* Show keyboard widget */
         ret = 1;
     }
@@ -43,15 +43,9 @@ static void
 print_list(gui_handle_p root) {
     static uint8_t depth = 0;
     gui_handle_p h;
-    gui_linkedlistroot_t* list;
     
     depth++;
-    if (root != NULL) {
-        list = &root->root_list;
-    } else {
-        list = &GUI.root;
-    }
-    for (h = list->first; h != NULL; h = h->list.next) {
+    GUI_LINKEDLIST_WIDGETSLISTNEXT(root, h) {
         GUI_DEBUG("%*d: W: %s; A: 0x%p, Hidden: %lu; Redraw: %lu; Remove: %lu\r\n",
             2 * depth, depth,
             (const char *)h->widget->name,
@@ -307,7 +301,7 @@ gui_linkedlistmulti_t *
 gui_linkedlist_multi_add_gen(gui_linkedlistroot_t* const root, void* const element) {
     gui_linkedlistmulti_t* ptr;
     
-    ptr = GUI_MEMALLOC(sizeof(gui_linkedlistmulti_t));  /* Create memory for linked list */
+    ptr = GUI_POOLALLOC(sizeof(gui_linkedlistmulti_t)); /* Create memory for linked list */
     if (ptr != NULL) {
         ptr->element = element;                     /* Save pointer to our element */
         gui_linkedlist_add_gen(root, &ptr->list);   /* Add element to linked list */
@@ -330,7 +324,7 @@ gui_linkedlist_multi_remove_gen(gui_linkedlistroot_t* const root, gui_linkedlist
         return 0;
     }
     gui_linkedlist_remove_gen(root, (gui_linkedlist_t *)element); /* Remove element from linked list */
-    GUI_MEMFREE(element);
+    GUI_POOLFREE(element, sizeof(*element));
     return 1;
 }
 
@@ -445,37 +439,190 @@ gui_linkedlist_multi_find_remove(gui_linkedlistroot_t* const root, void* const e
     return ret;
 }
 
+#if GUI_CFG_WIDGET_CHILD_ARRAY || __DOXYGEN__
+
+/**
+ * \brief           Get array of children widgets of parent widget
+ * \param[in]       parent: Parent widget handle or `NULL` for root array
+ * \return          Pointer to array of children widgets
+ */
+static gui_widgetarray_t *
+widget_array(gui_handle_p parent) {
+    return parent != NULL ? &parent->root_list : &GUI.root;
+}
+
+/**
+ * \brief           Get array where widget is currently placed
+ * \param[in]       h: Widget handle
+ * \return          Pointer to array on success, `NULL` if widget is not on array
+ */
+static gui_widgetarray_t *
+widget_array_get(gui_handle_p h) {
+    gui_widgetarray_t* arr = widget_array(guii_widget_getparent(h));
+    if (h->index < arr->count && arr->items[h->index] == h) {
+        return arr;
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Make sure array has space for at least one more widget
+ * \param[in]       arr: Pointer to widget array
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+widget_array_reserve(gui_widgetarray_t* arr) {
+    struct gui_handle** items;
+    uint32_t size;
+    
+    if (arr->count < arr->size) {                   /* There is space for new entry */
+        return 1;
+    }
+    size = arr->size ? 2 * (uint32_t)arr->size : 4; /* Double size of array */
+    if (size > 0xFFFF) {
+        size = 0xFFFF;
+    }
+    if (size <= arr->size) {                        /* Maximal number of children reached */
+        return 0;
+    }
+    if (arr->items == NULL) {                       /* First allocation, try with fast memory */
+        items = GUI_MEMALLOC_CLASS(size * sizeof(*items), GUI_MEM_CLASS_FAST);
+    } else {                                        /* Reallocation keeps memory class */
+        items = GUI_MEMREALLOC(arr->items, size * sizeof(*items));
+    }
+    if (items == NULL) {
+        return 0;
+    }
+    arr->items = items;
+    arr->size = (uint16_t)size;
+    return 1;
+}
+
+/**
+ * \brief           Move widget inside array to new position
+ * \note            Widgets between old and new position are shifted for one position
+ * \param[in]       arr: Pointer to widget array
+ * \param[in]       from: Current position of widget
+ * \param[in]       to: New position of widget
+ */
+static void
+widget_array_move(gui_widgetarray_t* arr, uint16_t from, uint16_t to) {
+    gui_handle_p h = arr->items[from];
+    uint16_t i;
+    
+    if (from < to) {
+        memmove(&arr->items[from], &arr->items[from + 1], (to - from) * sizeof(*arr->items));
+    } else if (from > to) {
+        memmove(&arr->items[to + 1], &arr->items[to], (from - to) * sizeof(*arr->items));
+    } else {
+        return;
+    }
+    arr->items[to] = h;
+    for (i = GUI_MIN(from, to); i <= GUI_MAX(from, to); i++) {
+        arr->items[i]->index = i;                   /* Update positions of moved widgets */
+    }
+}
+
+#endif /* GUI_CFG_WIDGET_CHILD_ARRAY || __DOXYGEN__ */
+
+/*
+ * Widget linked list order:
+ *
+ * 1. Normal widgets, with automatic or fixed z-index
+ * 2. Widgets with children support
+ * 3. Widgets as dialog base elements
+ */
+
+/**
+ * \brief           Check if widget may be moved over next widget in direction to bottom of list
+ * \param[in]       h: Widget to move
+ * \param[in]       next: Next widget of moving widget
+ * \return          `1` if move is allowed, `0` otherwise
+ */
+static uint8_t
+widget_canmovedown(gui_handle_p h, gui_handle_p next) {
+    if (guii_widget_isdialogbase(h)) {              /* Widget is dialog base element */
+        return 1;
+    } else if (guii_widget_allowchildren(h)) {      /* Widget supports children widgets, go to the end of the list if necessary */
+        return !guii_widget_isdialogbase(next)      /* Go down till dialog base is reached */
+            && guii_widget_ext(h)->zindex >= guii_widget_ext(next)->zindex; /* Check if z-index allows move */
+    }
+    return !guii_widget_allowchildren(next)         /* Allow moving down only if next widget does not allow sub widgets */
+        && guii_widget_ext(h)->zindex >= guii_widget_ext(next)->zindex;   /* Check if z-index allows move */
+}
+
+/**
+ * \brief           Check if widget may be moved over previous widget in direction to top of list
+ * \param[in]       h: Widget to move
+ * \param[in]       prev: Previous widget of moving widget
+ * \return          `1` if move is allowed, `0` otherwise
+ */
+static uint8_t
+widget_canmoveup(gui_handle_p h, gui_handle_p prev) {
+    if (guii_widget_isdialogbase(h)) {              /* Widget is dialog base element */
+        return guii_widget_isdialogbase(prev);      /* If previous widget is dialog base too */
+    } else if (guii_widget_allowchildren(h)) {      /* If moving widget allows children elements */
+        return guii_widget_allowchildren(prev)      /* If previous widget allows children too */
+            && guii_widget_ext(h)->zindex <= guii_widget_ext(prev)->zindex; /* Check if z-index allows move */
+    }
+    return guii_widget_ext(h)->zindex <= guii_widget_ext(prev)->zindex;   /* Check if z-index allows move */
+}
+
 /**
  * \brief           Add new widget to linked list of parent widget
  * \note            This function is private and may be called only when OS protection is active
  * \param[in]       parent: Pointer to parent widget where to put this widget on list
  * \param[in]       h: Widget handle to add to list 
+ * \return          `1` on success, `0` otherwise
  * \sa              gui_linkedlist_widgetremove
  */
-void
+uint8_t
 gui_linkedlist_widgetadd(gui_handle_p parent, gui_handle_p h) {    
+#if GUI_CFG_WIDGET_CHILD_ARRAY
+    gui_widgetarray_t* arr = widget_array(parent);
+    if (!widget_array_reserve(arr)) {               /* Make space for new widget */
+        return 0;
+    }
+    h->index = arr->count;
+    arr->items[arr->count++] = h;                   /* Add widget to the end of array */
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY */
     if (parent != NULL) {
         gui_linkedlist_add_gen(&parent->root_list, GUI_VP(h));
     } else {
         gui_linkedlist_add_gen(&GUI.root, GUI_VP(h));
     }
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
     gui_linkedlist_widgetmovetotop(h);              /* Reset by moving to top */
     gui_linkedlist_widgetmovetobottom(h);           /* Reset by moving to bottom with reorder */
+    return 1;
 }
 
 /**
  * \brief           Remove widget from linked list of parent widget
  * \note            This function is private and may be called only when OS protection is active
+ * \note            When \ref GUI_CFG_WIDGET_CHILD_ARRAY is enabled, array of children of widget is freed too
  * \param[in]       h: Widget handle to remove from linked list 
  * \sa              gui_linkedlist_widgetadd
  */
 void
 gui_linkedlist_widgetremove(gui_handle_p h) {    
+#if GUI_CFG_WIDGET_CHILD_ARRAY
+    gui_widgetarray_t* arr = widget_array_get(h);
+    if (arr != NULL) {
+        widget_array_move(arr, h->index, arr->count - 1);   /* Move widget to the end of array */
+        arr->count--;
+    }
+    if (h->root_list.items != NULL) {               /* Widget is removed, children array is not needed anymore */
+        GUI_MEMFREE(h->root_list.items);
+        h->root_list.count = h->root_list.size = 0;
+    }
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY */
     if (guii_widget_hasparent(h)) {
         gui_linkedlist_remove_gen(&(guii_widget_getparent(h)->root_list), GUI_VP(h));
     } else {
         gui_linkedlist_remove_gen(&GUI.root, GUI_VP(h));
     }
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
 }
 
 /**
@@ -487,10 +634,19 @@ gui_linkedlist_widgetremove(gui_handle_p h) {
  */
 uint8_t
 gui_linkedlist_widgetmoveup(gui_handle_p h) {
+#if GUI_CFG_WIDGET_CHILD_ARRAY
+    gui_widgetarray_t* arr = widget_array_get(h);
+    if (arr == NULL || h->index == 0) {
+        return 0;
+    }
+    widget_array_move(arr, h->index, h->index - 1);
+    return 1;
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY */
     if (guii_widget_hasparent(h)) {
         return gui_linkedlist_moveup_gen(&(guii_widget_getparent(h)->root_list), GUI_VP(h));
     }
     return gui_linkedlist_moveup_gen(&GUI.root, GUI_VP(h));
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
 }
 
 /**
@@ -502,10 +658,19 @@ gui_linkedlist_widgetmoveup(gui_handle_p h) {
  */
 uint8_t
 gui_linkedlist_widgetmovedown(gui_handle_p h) {
+#if GUI_CFG_WIDGET_CHILD_ARRAY
+    gui_widgetarray_t* arr = widget_array_get(h);
+    if (arr == NULL || h->index + 1 >= arr->count) {
+        return 0;
+    }
+    widget_array_move(arr, h->index, h->index + 1);
+    return 1;
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY */
     if (guii_widget_hasparent(h)) {
         return gui_linkedlist_movedown_gen(&(guii_widget_getparent(h)->root_list), GUI_VP(h));
     }
     return gui_linkedlist_movedown_gen(&GUI.root, GUI_VP(h));
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
 }
 
 /**
@@ -530,6 +695,18 @@ gui_linkedlist_widgetmovedown(gui_handle_p h) {
  */
 gui_handle_p
 gui_linkedlist_widgetgetnext(gui_handle_p parent, gui_handle_p h) {
+#if GUI_CFG_WIDGET_CHILD_ARRAY
+    gui_widgetarray_t* arr;
+    if (h == NULL) {                                /* Get first widget on array */
+        arr = widget_array(parent);
+        return arr->count > 0 ? arr->items[0] : NULL;
+    }
+    arr = widget_array_get(h);
+    if (arr != NULL && h->index + 1 < arr->count) {
+        return arr->items[h->index + 1];            /* Get next widget of current in array */
+    }
+    return NULL;
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY */
     if (h == NULL) {                                /* Get first widget on list */
         if (parent != NULL) {                       /* If parent exists... */
             return parent->root_list.first;         /* ...get first widget on parent */
@@ -538,6 +715,7 @@ gui_linkedlist_widgetgetnext(gui_handle_p parent, gui_handle_p h) {
         }
     }
     return h->list.next;                            /* Get next widget of current in linked list */
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
 }
 
 /**
@@ -562,6 +740,18 @@ gui_linkedlist_widgetgetnext(gui_handle_p parent, gui_handle_p h) {
  */
 gui_handle_p
 gui_linkedlist_widgetgetprev(gui_handle_p parent, gui_handle_p h) {
+#if GUI_CFG_WIDGET_CHILD_ARRAY
+    gui_widgetarray_t* arr;
+    if (h == NULL) {                                /* Get last widget on array */
+        arr = widget_array(parent);
+        return arr->count > 0 ? arr->items[arr->count - 1] : NULL;
+    }
+    arr = widget_array_get(h);
+    if (arr != NULL && h->index > 0) {
+        return arr->items[h->index - 1];            /* Get previous widget of current in array */
+    }
+    return NULL;
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY */
     if (h == NULL) {                                /* Get last widget on list */
         if (parent != NULL) {                       /* If parent exists... */
             return parent->root_list.last;          /* ...get last widget on parent */
@@ -570,15 +760,30 @@ gui_linkedlist_widgetgetprev(gui_handle_p parent, gui_handle_p h) {
         }
     }
     return h->list.prev;                            /* Get next widget of current in linked list */
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
 }
 
-/*
- * Widget linked list order:
- *
- * 1. Normal widgets, with automatic or fixed z-index
- * 2. Widgets with children support
- * 3. Widgets as dialog base elements
+/**
+ * \brief           Get widget by position in linked list of parent widget
+ * \note            When \ref GUI_CFG_WIDGET_CHILD_ARRAY is enabled, widget is accessed in constant time
+ * \note            This function is private and may be called only when OS protection is active
+ * \param[in]       parent: Parent widget handle or `NULL` for widgets on root list
+ * \param[in]       index: Position of widget on list, `0` is first widget
+ * \return          Widget handle on success, `NULL` otherwise
  */
+gui_handle_p
+gui_linkedlist_widgetgetbyindex(gui_handle_p parent, uint16_t index) {
+#if GUI_CFG_WIDGET_CHILD_ARRAY
+    gui_widgetarray_t* arr = widget_array(parent);
+    return index < arr->count ? arr->items[index] : NULL;
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY */
+    gui_handle_p h = gui_linkedlist_widgetgetnext(parent, NULL);
+    while (index-- && h != NULL) {                  /* Scroll to next widgets */
+        h = gui_linkedlist_widgetgetnext(NULL, h);
+    }
+    return h;
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
+}
 
 /**
  * \brief           Move widget to bottom in linked list of parent widget
@@ -589,44 +794,26 @@ gui_linkedlist_widgetgetprev(gui_handle_p parent, gui_handle_p h) {
  */
 uint8_t
 gui_linkedlist_widgetmovetobottom(gui_handle_p h) {
+    gui_handle_p next;
     uint32_t cnt = 0;
-    if (h->list.next == NULL) {
-        return 0;
+#if !GUI_CFG_WIDGET_CHILD_ARRAY
+    uint32_t i;
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
+    
+    /* Count widgets to move over */
+    for (next = gui_linkedlist_widgetgetnext(NULL, h); next != NULL && widget_canmovedown(h, next);
+        next = gui_linkedlist_widgetgetnext(NULL, next)) {
+        cnt++;
     }
-    while (h->list.next != NULL) {                  /* While device has next element */
-        if (guii_widget_isdialogbase(h)) {          /* Widget is dialog base element */
-            if (!gui_linkedlist_widgetmovedown(h)) {/* Move down */
-                break;
-            }
-            cnt++;
-        } else if (guii_widget_allowchildren(h)) { /* Widget supports children widgets, go to the end of the list if necessary */
-            if (!guii_widget_isdialogbase(h->list.next)) { /* Go down till dialog base is reached */
-                if (h->zindex >= __GH(h->list.next)->zindex) {  /* Check if z-index allows move */
-                    if (!gui_linkedlist_widgetmovedown(h)) {/* Move down */
-                        break;
-                    }
-                    cnt++;
-                } else {
-                    break;
-                }
-            } else {
-                break;
-            }
-        } else {                                    /* Our widget does not allow sub widgets */
-            if (!guii_widget_allowchildren(h->list.next)) {  /* Allow moving down only if next widget does not allow sub widgets */
-                if (h->zindex >= __GH(h->list.next)->zindex) {  /* Check if z-index allows move */
-                    if (!gui_linkedlist_widgetmovedown(h)) {/* Move down */
-                        break;
-                    }
-                    cnt++;
-                } else {
-                    break;
-                }
-            } else {
-                break;
-            }
-        }
+#if GUI_CFG_WIDGET_CHILD_ARRAY
+    if (cnt > 0) {
+        widget_array_move(widget_array_get(h), h->index, (uint16_t)(h->index + cnt));  /* Move with single memory move */
     }
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY */
+    for (i = 0; i < cnt; i++) {
+        gui_linkedlist_widgetmovedown(h);     /* Move down for one */
+    }
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
     return cnt;
 }
 
@@ -639,44 +826,26 @@ gui_linkedlist_widgetmovetobottom(gui_handle_p h) {
  */
 uint8_t
 gui_linkedlist_widgetmovetotop(gui_handle_p h) {
+    gui_handle_p prev;
     uint32_t cnt = 0;
-    if (h->list.prev == NULL) {
-        return 0;
+#if !GUI_CFG_WIDGET_CHILD_ARRAY
+    uint32_t i;
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
+    
+    /* Count widgets to move over */
+    for (prev = gui_linkedlist_widgetgetprev(NULL, h); prev != NULL && widget_canmoveup(h, prev);
+        prev = gui_linkedlist_widgetgetprev(NULL, prev)) {
+        cnt++;
     }
-    while (h->list.prev != NULL) {                  /* While device has previous element */
-        if (guii_widget_isdialogbase(h)) {          /* Widget is dialog base element */
-            if (guii_widget_isdialogbase(h->list.prev)) {   /* If previous widget is dialog base too */
-                if (!gui_linkedlist_widgetmoveup(h)) {  /* Move up widget */
-                    break;
-                }
-                cnt++;
-            } else {
-                break;                              /* Stop execution */
-            }
-        } else if (guii_widget_allowchildren(h)) {  /* If moving widget allows children elements */
-            if (guii_widget_allowchildren(h->list.prev)) {  /* If previous widget allows children too */
-                if (h->zindex <= __GH(h->list.prev)->zindex) {  /* Check if z-index allows move */
-                    if (!gui_linkedlist_widgetmoveup(h)) {  /* Move up */
-                        break;
-                    }
-                    cnt++;
-                } else {
-                    break;
-                }
-            } else {
-                break;                              /* Stop execution */
-            }
-        } else {                                    /* Normal widget */
-            if (h->zindex <= __GH(h->list.prev)->zindex) {  /* Check if z-index allows move */
-                if (!gui_linkedlist_widgetmoveup(h)) {  /* Move up */
-                    break;
-                }
-                cnt++;
-            } else {
-                break;
-            }
-        }
+#if GUI_CFG_WIDGET_CHILD_ARRAY
+    if (cnt > 0) {
+        widget_array_move(widget_array_get(h), h->index, (uint16_t)(h->index - cnt));  /* Move with single memory move */
+    }
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY */
+    for (i = 0; i < cnt; i++) {
+        gui_linkedlist_widgetmoveup(h);     /* Move up for one */
     }
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
     return cnt;
 }
 
@@ -34,6 +34,582 @@
 #include "gui/gui.h"
 #include "gui/gui_mem.h"
 
+/**
+ * \brief           Memory region used by allocator
+ */
+typedef struct {
+    uint8_t* start;                                 /*!< Start address of memory managed in region */
+    size_t size;                                    /*!< Size of memory managed in region */
+    size_t total;                                   /*!< Number of bytes available for allocation after assignment */
+    size_t used;                                    /*!< Number of bytes currently allocated, including block headers */
+    size_t max_used;                                /*!< Maximal number of bytes ever allocated in region */
+    uint32_t classes;                               /*!< Memory classes of region, \ref GUI_MEM_CLASS */
+#if GUI_CFG_MEM_TLSF || __DOXYGEN__
+    void* control;                                  /*!< Free lists of region, placed at the beginning of region memory */
+#endif /* GUI_CFG_MEM_TLSF || __DOXYGEN__ */
+} mem_regioninfo_t;
+
+static size_t MemAvailableBytes = 0;
+static size_t MemMinAvailableBytes = 0;
+static size_t MemTotalSize = 0;                     /* Size of memory in units of bytes */
+
+static mem_regioninfo_t MemRegions[GUI_CFG_MEM_MAX_REGIONS];    /* Regions in use */
+static size_t MemRegionsCount = 0;                  /* Number of regions in use */
+
+#if (GUI_CFG_OS && GUI_CFG_MEM_THREADSAFE) || __DOXYGEN__
+static gui_sys_mutex_t MemMutex;                    /* Memory manager protection */
+static uint8_t MemMutexValid = 0;                   /* Mutex was created */
+#define MEM_PROTECT()               do { if (MemMutexValid) { gui_sys_mutex_lock(&MemMutex); } } while (0)
+#define MEM_UNPROTECT()             do { if (MemMutexValid) { gui_sys_mutex_unlock(&MemMutex); } } while (0)
+#else /* (GUI_CFG_OS && GUI_CFG_MEM_THREADSAFE) || __DOXYGEN__ */
+#define MEM_PROTECT()
+#define MEM_UNPROTECT()
+#endif /* !((GUI_CFG_OS && GUI_CFG_MEM_THREADSAFE) || __DOXYGEN__) */
+
+/**
+ * \brief           Add region to list of regions in use
+ * \param[in]       start: Start address of memory managed in region
+ * \param[in]       size: Size of memory managed in region
+ * \param[in]       total: Number of bytes available for allocation in region
+ * \param[in]       classes: Memory classes of region, \ref GUI_MEM_CLASS
+ * \return          Added region
+ */
+static mem_regioninfo_t*
+mem_addregion(uint8_t* start, size_t size, size_t total, uint32_t classes) {
+    mem_regioninfo_t* r = &MemRegions[MemRegionsCount++];
+    
+    r->start = start;
+    r->size = size;
+    r->total = total;
+    r->classes = classes & ~GUI_MEM_CLASS_STRICT;
+    MemTotalSize += total;
+    MemAvailableBytes += total;
+    return r;
+}
+
+/**
+ * \brief           Get region of memory address
+ * \param[in]       ptr: Memory address
+ * \return          Region on success, `NULL` when address is not in any region
+ */
+static mem_regioninfo_t*
+mem_region_get(const void* ptr) {
+    mem_regioninfo_t* r;
+    size_t i;
+    
+    for (i = 0, r = MemRegions; i < MemRegionsCount; i++, r++) {
+        if ((const uint8_t *)ptr >= r->start && (const uint8_t *)ptr < r->start + r->size) {
+            return r;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Update statistics when memory block is allocated or freed
+ * \param[in]       r: Region of block
+ * \param[in]       size: Number of bytes allocated or freed, including block header
+ * \param[in]       alloc: Set to `1` when memory is allocated, `0` when freed
+ */
+static void
+mem_account(mem_regioninfo_t* r, size_t size, uint8_t alloc) {
+    if (alloc) {
+        MemAvailableBytes -= size;                  /* Decrease available memory */
+        if (MemAvailableBytes < MemMinAvailableBytes) { /* Check if current available memory is less than ever before */
+            MemMinAvailableBytes = MemAvailableBytes;   /* Update minimal available memory */
+        }
+        r->used += size;
+        if (r->used > r->max_used) {
+            r->max_used = r->used;
+        }
+    } else {
+        MemAvailableBytes += size;                  /* Increase available bytes back */
+        r->used -= size;
+    }
+}
+
+static void* mem_region_alloc(mem_regioninfo_t* r, size_t size);
+
+/**
+ * \brief           Allocate memory from regions of requested classes
+ *
+ *                  Regions are tried in 3 rounds, each in order of assignment: regions with all requested classes,
+ *                  regions with some of requested classes and all other regions.
+ *                  Only first round is used when \ref GUI_MEM_CLASS_STRICT flag is set
+ *
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       classes: Requested memory classes, \ref GUI_MEM_CLASS
+ * \return          Allocated memory on success, `NULL` otherwise
+ */
+static void*
+mem_allocex(size_t size, uint32_t classes) {
+    uint32_t want = classes & ~GUI_MEM_CLASS_STRICT, have;
+    uint8_t round, rounds;
+    size_t i;
+    void* ptr;
+    
+    rounds = (classes & GUI_MEM_CLASS_STRICT) ? 1 : 3;
+    for (round = 0; round < rounds; round++) {
+        for (i = 0; i < MemRegionsCount; i++) {
+            have = MemRegions[i].classes & want;
+            if ((have == want ? 0 : (have ? 1 : 2)) == round
+                && (ptr = mem_region_alloc(&MemRegions[i], size)) != NULL) {
+                return ptr;
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Allocate memory from any region */
+static void*
+mem_alloc(size_t size) {
+    return mem_allocex(size, GUI_MEM_CLASS_ANY);
+}
+
+#if GUI_CFG_MEM_TLSF || __DOXYGEN__
+
+/*
+ * Two-level segregated fit allocator
+ *
+ * Free blocks are kept in lists, one list for each size class.
+ * First level splits sizes by powers of 2, second level splits
+ * each power of 2 to MEM_SL_COUNT linear classes.
+ * Bitmaps tell which lists are not empty, so that allocation
+ * and free never walk over blocks and take constant time.
+ */
+
+/**
+ * \brief           Memory block header
+ *
+ *                  Fields `next_free` and `prev_free` are valid only in free blocks
+ *                  and are placed in block payload, allocated block has header of
+ *                  `prev_phys` and `size` only
+ */
+typedef struct mem_block {
+    struct mem_block* prev_phys;                    /*!< Physically previous block in region */
+    size_t size;                                    /*!< Size of block payload, lower bits are block flags */
+    struct mem_block* next_free;                    /*!< Next free block in the same list */
+    struct mem_block* prev_free;                    /*!< Previous free block in the same list */
+} mem_block_t;
+
+#if GUI_CFG_MEM_ALIGNMENT > 8
+#define MEM_ALIGN_LOG2              4
+#elif GUI_CFG_MEM_ALIGNMENT > 4 || UINTPTR_MAX > 0xFFFFFFFFUL
+#define MEM_ALIGN_LOG2              3
+#else
+#define MEM_ALIGN_LOG2              2               /* Lower 2 bits of size are always used for flags */
+#endif
+#define MEM_ALIGN_NUM               ((size_t)1 << MEM_ALIGN_LOG2)
+#define MEM_ALIGN(x)                (((x) + (MEM_ALIGN_NUM - 1)) & ~(MEM_ALIGN_NUM - 1))
+
+#define MEM_SL_LOG2                 4               /* Number of second level lists for each first level is 2^MEM_SL_LOG2 */
+#define MEM_SL_COUNT                (1UL << MEM_SL_LOG2)
+#define MEM_FL_SHIFT                (MEM_SL_LOG2 + MEM_ALIGN_LOG2)
+#define MEM_FL_MAX                  24              /* Blocks are smaller than 2^MEM_FL_MAX bytes */
+#define MEM_FL_COUNT                (MEM_FL_MAX - MEM_FL_SHIFT + 1)
+#define MEM_SMALL_BLOCK             ((size_t)1 << MEM_FL_SHIFT) /* Blocks below are split linearly in first list */
+
+#define MEM_BLOCK_FREE              ((size_t)0x01)  /* Block is free */
+#define MEM_BLOCK_PREV_FREE         ((size_t)0x02)  /* Physically previous block is free */
+#define MEM_BLOCK_FLAGS             (MEM_BLOCK_FREE | MEM_BLOCK_PREV_FREE)
+
+#define MEM_BLOCK_HDR               MEM_ALIGN(offsetof(mem_block_t, next_free))
+#define MEM_BLOCK_MIN               GUI_MAX(MEM_ALIGN(sizeof(mem_block_t)) - MEM_BLOCK_HDR, MEM_ALIGN_NUM)
+#define MEM_BLOCK_MAX               (((size_t)1 << MEM_FL_MAX) - MEM_ALIGN_NUM)
+
+#define mem_block_size(b)           ((b)->size & ~MEM_BLOCK_FLAGS)
+#define mem_block_isfree(b)         ((b)->size & MEM_BLOCK_FREE)
+#define mem_block_next(b)           ((mem_block_t *)((uint8_t *)(b) + MEM_BLOCK_HDR + mem_block_size(b)))
+#define mem_block_frompayload(p)    ((mem_block_t *)((uint8_t *)(p) - MEM_BLOCK_HDR))
+#define mem_block_topayload(b)      ((void *)((uint8_t *)(b) + MEM_BLOCK_HDR))
+
+/**
+ * \brief           Free lists of single region
+ *
+ *                  Every region has its own lists, so that allocation can be
+ *                  limited to regions of requested memory classes
+ */
+typedef struct {
+    uint32_t fl_bitmap;                             /*!< Bit is set when any list on first level is not empty */
+    uint32_t sl_bitmap[MEM_FL_COUNT];               /*!< Bit is set when list on second level is not empty */
+    mem_block_t* lists[MEM_FL_COUNT][MEM_SL_COUNT]; /*!< Free lists of all size classes */
+} mem_control_t;
+
+#define MEM_CONTROL_SIZE            MEM_ALIGN(sizeof(mem_control_t))
+
+static uint8_t mem_assigned;                        /* Regions were already assigned */
+
+/**
+ * \brief           Get index of most significant set bit
+ * \param[in]       x: Value, must not be `0`
+ * \return          Bit index
+ */
+static uint8_t
+mem_fls(uint32_t x) {
+    uint8_t bit = 0;
+    
+    if (x & 0xFFFF0000UL) { x >>= 16; bit += 16; }
+    if (x & 0x0000FF00UL) { x >>= 8; bit += 8; }
+    if (x & 0x000000F0UL) { x >>= 4; bit += 4; }
+    if (x & 0x0000000CUL) { x >>= 2; bit += 2; }
+    if (x & 0x00000002UL) { bit += 1; }
+    return bit;
+}
+
+/**
+ * \brief           Get index of least significant set bit
+ * \param[in]       x: Value, must not be `0`
+ * \return          Bit index
+ */
+static uint8_t
+mem_ffs(uint32_t x) {
+    return mem_fls(x & (~x + 1));                   /* Keep only lowest set bit */
+}
+
+/**
+ * \brief           Get list indexes for block size
+ * \param[in]       size: Block payload size
+ * \param[out]      fl: First level index
+ * \param[out]      sl: Second level index
+ */
+static void
+mem_mapping(size_t size, uint8_t* fl, uint8_t* sl) {
+    uint8_t bit;
+    
+    if (size < MEM_SMALL_BLOCK) {
+        *fl = 0;
+        *sl = (uint8_t)(size >> MEM_ALIGN_LOG2);
+    } else {
+        bit = mem_fls((uint32_t)size);
+        *sl = (uint8_t)((size >> (bit - MEM_SL_LOG2)) ^ MEM_SL_COUNT);
+        *fl = (uint8_t)(bit - MEM_FL_SHIFT + 1);
+    }
+}
+
+/**
+ * \brief           Remove free block from its list
+ * \param[in]       ctl: Free lists of block region
+ * \param[in]       block: Free block
+ */
+static void
+mem_list_remove(mem_control_t* ctl, mem_block_t* block) {
+    uint8_t fl, sl;
+    
+    mem_mapping(mem_block_size(block), &fl, &sl);
+    if (block->prev_free != NULL) {
+        block->prev_free->next_free = block->next_free;
+    } else {
+        ctl->lists[fl][sl] = block->next_free;      /* Block was first in list */
+        if (block->next_free == NULL) {             /* List is now empty */
+            ctl->sl_bitmap[fl] &= ~(1UL << sl);
+            if (!ctl->sl_bitmap[fl]) {
+                ctl->fl_bitmap &= ~(1UL << fl);
+            }
+        }
+    }
+    if (block->next_free != NULL) {
+        block->next_free->prev_free = block->prev_free;
+    }
+}
+
+/**
+ * \brief           Insert free block to list of its size class
+ * \param[in]       ctl: Free lists of block region
+ * \param[in]       block: Free block
+ */
+static void
+mem_list_insert(mem_control_t* ctl, mem_block_t* block) {
+    uint8_t fl, sl;
+    
+    mem_mapping(mem_block_size(block), &fl, &sl);
+    block->prev_free = NULL;
+    block->next_free = ctl->lists[fl][sl];
+    if (block->next_free != NULL) {
+        block->next_free->prev_free = block;
+    }
+    ctl->lists[fl][sl] = block;
+    ctl->fl_bitmap |= 1UL << fl;
+    ctl->sl_bitmap[fl] |= 1UL << sl;
+}
+
+/**
+ * \brief           Find free block with at least required size
+ * \param[in]       ctl: Free lists of region
+ * \param[in]       size: Required payload size, already aligned
+ * \return          Free block on success, `NULL` otherwise
+ */
+static mem_block_t*
+mem_list_find(mem_control_t* ctl, size_t size) {
+    uint32_t map;
+    uint8_t fl, sl;
+    
+    /* Round size up to next class, so that any block in found list is big enough */
+    if (size >= MEM_SMALL_BLOCK) {
+        size += ((size_t)1 << (mem_fls((uint32_t)size) - MEM_SL_LOG2)) - 1;
+    }
+    mem_mapping(size, &fl, &sl);
+    if (fl >= MEM_FL_COUNT) {
+        return NULL;
+    }
+    
+    map = ctl->sl_bitmap[fl] & (~0UL << sl);        /* Lists of the same first level */
+    if (!map) {
+        map = fl + 1 < MEM_FL_COUNT ? (ctl->fl_bitmap & (~0UL << (fl + 1))) : 0;
+        if (!map) {
+            return NULL;                            /* No block big enough */
+        }
+        fl = mem_ffs(map);
+        map = ctl->sl_bitmap[fl];
+    }
+    return ctl->lists[fl][mem_ffs(map)];
+}
+
+/**
+ * \brief           Mark block as free, merge it with free neighbours and put it to free list
+ * \param[in]       ctl: Free lists of block region
+ * \param[in]       block: Block to release
+ */
+static void
+mem_block_release(mem_control_t* ctl, mem_block_t* block) {
+    mem_block_t* next;
+    
+    block->size |= MEM_BLOCK_FREE;
+    if (block->size & MEM_BLOCK_PREV_FREE) {        /* Merge with previous block */
+        mem_block_t* prev = block->prev_phys;
+        mem_list_remove(ctl, prev);
+        prev->size += MEM_BLOCK_HDR + mem_block_size(block);
+        block = prev;
+    }
+    next = mem_block_next(block);
+    if (mem_block_isfree(next)) {                   /* Merge with next block */
+        mem_list_remove(ctl, next);
+        block->size += MEM_BLOCK_HDR + mem_block_size(next);
+        next = mem_block_next(block);
+    }
+    next->prev_phys = block;
+    next->size |= MEM_BLOCK_PREV_FREE;
+    mem_list_insert(ctl, block);
+}
+
+/**
+ * \brief           Cut end of used block to new free block if it is big enough
+ * \param[in]       ctl: Free lists of block region
+ * \param[in]       block: Used block
+ * \param[in]       size: Required payload size of block, already aligned
+ */
+static void
+mem_block_trim(mem_control_t* ctl, mem_block_t* block, size_t size) {
+    mem_block_t* rest;
+    
+    if (mem_block_size(block) >= size + MEM_BLOCK_HDR + MEM_BLOCK_MIN) {
+        rest = (mem_block_t *)((uint8_t *)block + MEM_BLOCK_HDR + size);
+        rest->size = mem_block_size(block) - size - MEM_BLOCK_HDR;  /* Previous block is used */
+        rest->prev_phys = block;
+        block->size = size | (block->size & MEM_BLOCK_FLAGS);
+        mem_block_next(rest)->prev_phys = rest;
+        mem_block_release(ctl, rest);
+    }
+}
+
+/**
+ * \brief           Get aligned payload size for requested number of bytes
+ * \param[in]       size: Requested number of bytes
+ * \return          Payload size or `0` if size is not valid
+ */
+static size_t
+mem_adjustsize(size_t size) {
+    if (!size || size > MEM_BLOCK_MAX) {
+        return 0;
+    }
+    size = MEM_ALIGN(size);
+    return size < MEM_BLOCK_MIN ? MEM_BLOCK_MIN : size;
+}
+
+uint8_t
+mem_assignmem(const mem_region_t* regions, size_t len) {
+    mem_block_t *block, *end;
+    mem_control_t* ctl;
+    uint8_t *addr, *start;
+    size_t size, chunk, total;
+    
+    if (mem_assigned || len > GUI_CFG_MEM_MAX_REGIONS) {    /* Regions already defined or too many of them */
+        return 0;
+    }
+    
+    for (; len--; regions++) {
+        /* Align start address and size of region */
+        addr = (uint8_t *)regions->start_address;
+        size = regions->size;
+        if ((size_t)addr & (MEM_ALIGN_NUM - 1)) {
+            chunk = MEM_ALIGN_NUM - ((size_t)addr & (MEM_ALIGN_NUM - 1));
+            if (size < chunk) {
+                continue;
+            }
+            addr += chunk;
+            size -= chunk;
+        }
+        size &= ~(MEM_ALIGN_NUM - 1);
+        if (size < MEM_CONTROL_SIZE) {
+            continue;
+        }
+        
+        /* Free lists of region are at the beginning of region */
+        ctl = (mem_control_t *)addr;
+        memset(ctl, 0x00, sizeof(*ctl));
+        addr += MEM_CONTROL_SIZE;
+        size -= MEM_CONTROL_SIZE;
+        start = addr;
+        total = 0;
+        
+        /*
+         * Every chunk of region has one free block and
+         * end block of size 0 which is always in use.
+         * Big regions are split to more chunks as block size is limited
+         */
+        while (size >= 2 * MEM_BLOCK_HDR + MEM_BLOCK_MIN) {
+            chunk = GUI_MIN(size - MEM_BLOCK_HDR, MEM_BLOCK_MAX + MEM_BLOCK_HDR);
+            block = (mem_block_t *)addr;
+            block->prev_phys = NULL;
+            block->size = chunk - MEM_BLOCK_HDR;
+            end = mem_block_next(block);
+            end->prev_phys = block;
+            end->size = 0;
+            total += chunk;
+            mem_block_release(ctl, block);
+            
+            addr += chunk + MEM_BLOCK_HDR;
+            size -= chunk + MEM_BLOCK_HDR;
+        }
+        if (total > 0) {
+            mem_addregion(start, addr - start, total, regions->classes)->control = ctl;
+        }
+    }
+    
+    mem_assigned = 1;
+    MemMinAvailableBytes = MemAvailableBytes;       /* Save minimum ever available bytes in region */
+    return 1;
+}
+
+/* Allocate memory from single region */
+static void*
+mem_region_alloc(mem_regioninfo_t* r, size_t size) {
+    mem_control_t* ctl = r->control;
+    mem_block_t *block, *next;
+    
+    size = mem_adjustsize(size);
+    if (!size || (block = mem_list_find(ctl, size)) == NULL) {
+        return NULL;
+    }
+    
+    mem_list_remove(ctl, block);
+    block->size &= ~MEM_BLOCK_FREE;                 /* Block is now allocated */
+    next = mem_block_next(block);
+    next->size &= ~MEM_BLOCK_PREV_FREE;
+    mem_block_trim(ctl, block, size);               /* Return remaining memory back to free lists */
+    mem_account(r, MEM_BLOCK_HDR + mem_block_size(block), 1);
+    return mem_block_topayload(block);
+}
+
+static void
+mem_free(void* ptr) {
+    mem_regioninfo_t* r;
+    mem_block_t* block;
+    
+    if (ptr == NULL) {                              /* To be in compliance with C free function */
+        return;
+    }
+    
+    block = mem_block_frompayload(ptr);
+    r = mem_region_get(block);
+    if (r != NULL && !mem_block_isfree(block)) {    /* Free only allocated blocks */
+        mem_account(r, MEM_BLOCK_HDR + mem_block_size(block), 0);
+        mem_block_release(r->control, block);
+    }
+}
+
+/* Reallocate previously allocated memory, grow in place when possible */
+static void*
+mem_realloc(void* ptr, size_t size) {
+    mem_regioninfo_t* r;
+    mem_block_t *block, *next;
+    void* newPtr;
+    size_t oldSize, newSize;
+    
+    if (!ptr) {                                     /* If pointer is not valid */
+        return mem_alloc(size);                     /* Only allocate memory */
+    }
+    
+    newSize = mem_adjustsize(size);
+    block = mem_block_frompayload(ptr);
+    r = mem_region_get(block);
+    if (!newSize || r == NULL || mem_block_isfree(block)) {
+        return 0;
+    }
+    oldSize = mem_block_size(block);
+    
+    /* Use free block right after current one when big enough together */
+    next = mem_block_next(block);
+    if (newSize > oldSize && mem_block_isfree(next)
+        && oldSize + MEM_BLOCK_HDR + mem_block_size(next) >= newSize) {
+        mem_list_remove(r->control, next);
+        block->size += MEM_BLOCK_HDR + mem_block_size(next);
+        mem_block_next(block)->prev_phys = block;
+        mem_block_next(block)->size &= ~MEM_BLOCK_PREV_FREE;
+    }
+    
+    if (newSize <= mem_block_size(block)) {         /* Resize in place */
+        mem_block_trim(r->control, block, newSize);
+        if (mem_block_size(block) > oldSize) {
+            mem_account(r, mem_block_size(block) - oldSize, 1);
+        } else {
+            mem_account(r, oldSize - mem_block_size(block), 0);
+        }
+        return ptr;
+    }
+    
+    newPtr = mem_allocex(size, r->classes);         /* Try to allocate new memory block of the same classes */
+    if (newPtr != NULL) {                           /* Check success */
+        memcpy(newPtr, ptr, oldSize);               /* Copy old data to new array */
+        mem_free(ptr);                              /* Free old pointer */
+    }
+    return newPtr;
+}
+
+/**
+ * \brief           Call function for every block in region
+ * \param[in]       r: Region to walk over
+ * \param[in]       index: Index of region
+ * \param[in]       fn: Function to call for every block
+ * \param[in]       arg: Custom user argument for function
+ * \return          `1` when all blocks were walked, `0` when function stopped the walk
+ */
+static uint8_t
+mem_walkregion(const mem_regioninfo_t* r, size_t index, gui_mem_walk_fn fn, void* arg) {
+    gui_mem_block_t info;
+    mem_block_t* block;
+    uint8_t* addr;
+    
+    info.region = index;
+    for (addr = r->start; addr < r->start + r->size; ) {
+        block = (mem_block_t *)addr;
+        if (!mem_block_size(block) && !mem_block_isfree(block)) {
+            addr += MEM_BLOCK_HDR;                  /* Skip end block of chunk */
+            continue;
+        }
+        info.address = mem_block_topayload(block);
+        info.size = MEM_BLOCK_HDR + mem_block_size(block);
+        info.used = !mem_block_isfree(block);
+        if (!fn(&info, arg)) {
+            return 0;
+        }
+        addr = (uint8_t *)mem_block_next(block);
+    }
+    return 1;
+}
+
+#else /* GUI_CFG_MEM_TLSF || __DOXYGEN__ */
+
 typedef struct MemBlock {
     struct MemBlock* NextFreeBlock;                 /*!< Pointer to next free block */
     size_t Size;                                    /*!< Size of block */
@@ -50,11 +626,16 @@ typedef struct MemBlock {
 
 static MemBlock_t StartBlock;
 static MemBlock_t* EndBlock = 0;
-static size_t MemAvailableBytes = 0;
-static size_t MemMinAvailableBytes = 0;
 static size_t MemAllocBit = 0;
 
-static size_t MemTotalSize = 0;                     /* Size of memory in units of bytes */
+/* Get memory classes to use for reallocation of memory */
+static uint32_t
+mem_getclasses(const void* ptr) {
+    mem_regioninfo_t* r = mem_region_get(ptr);
+    
+    return r != NULL ? r->classes : GUI_MEM_CLASS_ANY;
+}
+
 /* Insert block to list of free blocks */
 static void
 mem_insertfreeblock(MemBlock_t* newBlock) {
@@ -108,7 +689,7 @@ mem_assignmem(const mem_region_t* regions, size_t len) {
     MemBlock_t* PreviousEndBlock = 0;
     size_t i;
     
-    if (EndBlock != NULL) {                         /* Regions already defined */
+    if (EndBlock != NULL || len > GUI_CFG_MEM_MAX_REGIONS) {  /* Regions already defined or too many of them */
         return 0;
     }
     
@@ -184,7 +765,7 @@ mem_assignmem(const mem_region_t* regions, size_t len) {
         }
         
         /* Set number of free bytes available to allocate in region */
-        MemAvailableBytes += FirstBlock->Size;
+        mem_addregion(MemStartAddr, MemSize, FirstBlock->Size, regions->classes);
         
         regions++;                                  /* Go to next region */
     }
@@ -199,9 +780,11 @@ mem_assignmem(const mem_region_t* regions, size_t len) {
     return 1;                                       /* Regions set as expected */
 }
 
+/* Allocate memory from single region */
 static void*
-mem_alloc(size_t size) {
+mem_region_alloc(mem_regioninfo_t* r, size_t size) {
     MemBlock_t *Prev, *Curr, *Next;
+    uint8_t* end = r->start + r->size;
     void* retval = 0;
 
     if (EndBlock == NULL) {                         /* If end block is not yet defined */
@@ -220,12 +803,14 @@ mem_alloc(size_t size) {
 
     /*
      * Try to find sufficient block for data
-     * Go through free blocks until enough memory is found
-     * or end block is reached (no next free block)
+     * Go through free blocks until enough memory is found in region,
+     * end of region is passed or end block is reached (no next free block).
+     * Free blocks are in address order, blocks of region are one after another
      */
     Prev = &StartBlock;                             /* Set first first block as previous */
     Curr = Prev->NextFreeBlock;                     /* Set next block as current */
-    while ((Curr->Size < size) && (Curr->NextFreeBlock)) {
+    while ((Curr->Size < size || (uint8_t *)Curr < r->start)
+        && (uint8_t *)Curr < end && (Curr->NextFreeBlock)) {
         Prev = Curr;
         Curr = Curr->NextFreeBlock;
     }
@@ -237,7 +822,7 @@ mem_alloc(size_t size) {
      * Feature may be very risky later because of fragmentation
      */
     
-    if (Curr != EndBlock) {                         /* We found empty block of enough memory available */
+    if (Curr->Size >= size && (uint8_t *)Curr >= r->start && (uint8_t *)Curr < end) { /* We found empty block of enough memory available */
         retval = (void *)((uint8_t *)Prev->NextFreeBlock + MEMBLOCK_METASIZE);    /* Set return value */
         Prev->NextFreeBlock = Curr->NextFreeBlock;  /* Since block is now allocated, remove it from free chain */
 
@@ -257,13 +842,9 @@ mem_alloc(size_t size) {
              */
             mem_insertfreeblock(Next);              /* Insert free memory block to list of free memory blocks (linked list chain) */
         }
+        mem_account(r, Curr->Size, 1);              /* Whole block is used when it was not split */
         Curr->Size |= MemAllocBit;                  /* Set allocated bit = memory is allocated */
         Curr->NextFreeBlock = 0;                    /* Clear next free block pointer as there is no one */
-
-        MemAvailableBytes -= size;                  /* Decrease available memory */
-        if (MemAvailableBytes < MemMinAvailableBytes) { /* Check if current available memory is less than ever before */
-            MemMinAvailableBytes = MemAvailableBytes;   /* Update minimal available memory */
-        }
     } else {
         /* Allocation failed, no free blocks of required size */
     }
@@ -273,6 +854,7 @@ mem_alloc(size_t size) {
 
 static void
 mem_free(void* ptr) {
+    mem_regioninfo_t* r;
     MemBlock_t* block;
 
     if (ptr == NULL) {                              /* To be in compliance with C free function */
@@ -285,13 +867,13 @@ mem_free(void* ptr) {
      * Check if block is even allocated by upper bit on size
      * and next free block must be set to NULL in order to work properly
      */
-    if ((block->Size & MemAllocBit) && !block->NextFreeBlock) {
+    if ((block->Size & MemAllocBit) && !block->NextFreeBlock && (r = mem_region_get(block)) != NULL) {
         /*
          * Clear allocated bit before entering back to free list
          * List will automatically take care for fragmentation and mix segments back
          */
         block->Size &= ~MemAllocBit;                /* Clear allocated bit */
-        MemAvailableBytes += block->Size;           /* Increase available bytes back */
+        mem_account(r, block->Size, 0);             /* Increase available bytes back */
         mem_insertfreeblock(block);                 /* Insert block to list of free blocks */
     }
 }
@@ -311,18 +893,6 @@ mem_getusersize(void* ptr) {
     return 0;
 }
 
-/* Allocate memory and set it to 0 */
-static void*
-mem_calloc(size_t num, size_t size) {
-    void* ptr;
-    size_t tot_len = num * size;
-    
-    if ((ptr = mem_alloc(tot_len)) != NULL) {       /* Try to allocate memory */
-        memset(ptr, 0x00, tot_len);                 /* Reset entire memory */
-    }
-    return ptr;
-}
-
 /* Reallocate previously allocated memory */
 static void*
 mem_realloc(void* ptr, size_t size) {
@@ -334,7 +904,7 @@ mem_realloc(void* ptr, size_t size) {
     }
     
     oldSize = mem_getusersize(ptr);                 /* Get size of old pointer */
-    newPtr = mem_alloc(size);                       /* Try to allocate new memory block */
+    newPtr = mem_allocex(size, mem_getclasses(ptr));    /* Try to allocate new memory block of the same classes */
     if (newPtr != NULL) {                           /* Check success */
         memcpy(newPtr, ptr, size > oldSize ? oldSize : size);   /* Copy old data to new array */
         mem_free(ptr);                              /* Free old pointer */
@@ -343,6 +913,51 @@ mem_realloc(void* ptr, size_t size) {
     return 0;
 }
 
+/**
+ * \brief           Call function for every block in region
+ * \param[in]       r: Region to walk over
+ * \param[in]       index: Index of region
+ * \param[in]       fn: Function to call for every block
+ * \param[in]       arg: Custom user argument for function
+ * \return          `1` when all blocks were walked, `0` when function stopped the walk
+ */
+static uint8_t
+mem_walkregion(const mem_regioninfo_t* r, size_t index, gui_mem_walk_fn fn, void* arg) {
+    gui_mem_block_t info;
+    MemBlock_t* block;
+    uint8_t* end;
+    
+    info.region = index;
+    end = r->start + r->size - MEMBLOCK_METASIZE;   /* End block of region */
+    for (block = (MemBlock_t *)r->start; (uint8_t *)block < end; ) {
+        info.address = (uint8_t *)block + MEMBLOCK_METASIZE;
+        info.size = block->Size & ~MemAllocBit;
+        info.used = (block->Size & MemAllocBit) ? 1 : 0;
+        if (!info.size) {                           /* Invalid block, heap is corrupted */
+            break;
+        }
+        if (!fn(&info, arg)) {
+            return 0;
+        }
+        block = (MemBlock_t *)((uint8_t *)block + info.size);
+    }
+    return 1;
+}
+
+#endif /* !(GUI_CFG_MEM_TLSF || __DOXYGEN__) */
+
+/* Allocate memory of requested classes and set it to 0 */
+static void*
+mem_calloc(size_t num, size_t size, uint32_t classes) {
+    void* ptr;
+    size_t tot_len = num * size;
+    
+    if ((ptr = mem_allocex(tot_len, classes)) != NULL) {   /* Try to allocate memory */
+        memset(ptr, 0x00, tot_len);                 /* Reset entire memory */
+    }
+    return ptr;
+}
+
 static size_t
 mem_getfree(void) {
     return MemAvailableBytes;                       /* Return free bytes available for allocation */
@@ -358,6 +973,83 @@ mem_getminfree(void) {
     return MemMinAvailableBytes;                    /* Return minimal bytes ever available */
 }
 
+/* Call function for every block in all regions */
+static uint8_t
+mem_walk(gui_mem_walk_fn fn, void* arg) {
+    size_t i;
+    
+    for (i = 0; i < MemRegionsCount; i++) {
+        if (!mem_walkregion(&MemRegions[i], i, fn, arg)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Statistics collection of blocks */
+typedef struct {
+    gui_mem_stats_t* stats;                         /* Statistics to fill */
+    size_t region;                                  /* Region to collect or \ref GUI_MEM_REGION_ALL */
+} mem_statsctx_t;
+
+/* Add block to statistics */
+static uint8_t
+mem_stats_block(const gui_mem_block_t* block, void* arg) {
+    mem_statsctx_t* ctx = arg;
+    gui_mem_stats_t* stats = ctx->stats;
+    size_t i;
+    
+    if (ctx->region != GUI_MEM_REGION_ALL && ctx->region != block->region) {
+        return 1;
+    }
+    if (block->used) {
+        stats->used_blocks++;
+    } else {
+        stats->free_blocks++;
+        if (block->size > stats->largest_free) {
+            stats->largest_free = block->size;
+        }
+        for (i = 0; i < GUI_MEM_STATS_CLASSES - 1 && block->size >= ((size_t)32 << i); i++) {}
+        stats->free_histogram[i]++;
+    }
+    return 1;
+}
+
+/* Dump writer */
+typedef struct {
+    uint8_t* buff;                                  /* Output buffer */
+    size_t len;                                     /* Length of output buffer */
+    size_t pos;                                     /* Current position, may be larger than buffer length */
+    size_t count;                                   /* Number of blocks in region */
+} mem_dumpctx_t;
+
+/* Write 32-bit value to dump in little endian format */
+static void
+mem_dump_u32(mem_dumpctx_t* ctx, uint32_t value) {
+    uint8_t i;
+    
+    for (i = 0; i < 4; i++, ctx->pos++) {
+        if (ctx->pos < ctx->len) {
+            ctx->buff[ctx->pos] = (uint8_t)(value >> (8 * i));
+        }
+    }
+}
+
+/* Count blocks of region */
+static uint8_t
+mem_dump_count(const gui_mem_block_t* block, void* arg) {
+    GUI_UNUSED(block);
+    ((mem_dumpctx_t *)arg)->count++;
+    return 1;
+}
+
+/* Write block to dump */
+static uint8_t
+mem_dump_block(const gui_mem_block_t* block, void* arg) {
+    mem_dump_u32(arg, (uint32_t)block->size | (block->used ? 0x80000000UL : 0));
+    return 1;
+}
+
 /**
  * \brief           Allocate memory of specific size
  * \note            This function is private and may be called only when OS protection is active
@@ -368,7 +1060,9 @@ gui_mem_alloc(uint32_t size) {
     void* ptr;
 
 #if GUI_CFG_USE_MEM
+    MEM_PROTECT();
     ptr = mem_alloc(size);                          /* Allocate memory and return pointer */
+    MEM_UNPROTECT();
 #else /* GUI_CFG_USE_MEM */
     ptr = malloc(size);
 #endif /* !GUI_CFG_USE_MEM */
@@ -385,7 +1079,9 @@ gui_mem_alloc(uint32_t size) {
 void*
 gui_mem_realloc(void* ptr, size_t size) {
 #if GUI_CFG_USE_MEM
+    MEM_PROTECT();
     ptr = mem_realloc(ptr, size);                   /* Reallocate and return pointer */
+    MEM_UNPROTECT();
 #else /* GUI_CFG_USE_MEM */
     ptr = realloc(ptr, size);
 #endif /* GUI_CFG_USE_MEM */
@@ -403,8 +1099,61 @@ gui_mem_calloc(size_t num, size_t size) {
     void* ptr;
 
 #if GUI_CFG_USE_MEM
-    ptr = mem_calloc(num, size);                    /* Allocate memory and clear it to 0. Then return pointer */
+    MEM_PROTECT();
+    ptr = mem_calloc(num, size, GUI_MEM_CLASS_ANY); /* Allocate memory and clear it to 0. Then return pointer */
+    MEM_UNPROTECT();
+#else /* GUI_CFG_USE_MEM */
+    ptr = calloc(num, size);
+#endif /* !GUI_CFG_USE_MEM */
+    return ptr;
+}
+
+/**
+ * \brief           Allocate memory of specific size from regions of requested memory classes
+ *
+ *                  Regions with all requested classes are used first. When they are full,
+ *                  regions with some of requested classes and then all other regions are used,
+ *                  unless \ref GUI_MEM_CLASS_STRICT flag is set
+ *
+ * \note            This function is private and may be called only when OS protection is active
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       classes: Requested memory classes, \ref GUI_MEM_CLASS
+ * \return          Allocated memory on success, `NULL` otherwise
+ */
+void*
+gui_mem_allocex(size_t size, uint32_t classes) {
+    void* ptr;
+
+#if GUI_CFG_USE_MEM
+    MEM_PROTECT();
+    ptr = mem_allocex(size, classes);
+    MEM_UNPROTECT();
+#else /* GUI_CFG_USE_MEM */
+    GUI_UNUSED(classes);
+    ptr = malloc(size);
+#endif /* !GUI_CFG_USE_MEM */
+    return ptr;
+}
+
+/**
+ * \brief           Allocate memory of specific size from regions of requested memory classes and set memory to zero
+ * \note            This function is private and may be called only when OS protection is active
+ * \param[in]       num: Number of elements to allocate
+ * \param[in]       size: Size of each element
+ * \param[in]       classes: Requested memory classes, \ref GUI_MEM_CLASS
+ * \return          Allocated memory on success, `NULL` otherwise
+ * \sa              gui_mem_allocex
+ */
+void*
+gui_mem_callocex(size_t num, size_t size, uint32_t classes) {
+    void* ptr;
+
+#if GUI_CFG_USE_MEM
+    MEM_PROTECT();
+    ptr = mem_calloc(num, size, classes);
+    MEM_UNPROTECT();
 #else /* GUI_CFG_USE_MEM */
+    GUI_UNUSED(classes);
     ptr = calloc(num, size);
 #endif /* !GUI_CFG_USE_MEM */
     return ptr;
@@ -417,7 +1166,9 @@ gui_mem_calloc(size_t num, size_t size) {
 void
 gui_mem_free(void* ptr) {
 #if GUI_CFG_USE_MEM
+    MEM_PROTECT();
     mem_free(ptr);                                  /* Free already allocated memory */
+    MEM_UNPROTECT();
 #else /* GUI_CFG_USE_MEM */
     free(ptr);
 #endif /* !GUI_CFG_USE_MEM */
@@ -453,9 +1204,440 @@ gui_mem_getminfree(void) {
     return mem_getminfree();                        /* Get minimal number of bytes ever available for allocation */
 }
 
+/**
+ * \brief           Get size of largest free block
+ * \note            This function is private and may be called only when OS protection is active
+ * \return          Size of largest free block in units of bytes, including block header
+ */
+size_t
+gui_mem_getlargestfree(void) {
+    gui_mem_stats_t stats;
+    
+    gui_mem_getstats(&stats, GUI_MEM_REGION_ALL);
+    return stats.largest_free;
+}
+
+/**
+ * \brief           Get number of regions in use by memory manager
+ * \return          Number of regions
+ */
+size_t
+gui_mem_getregioncount(void) {
+    return MemRegionsCount;
+}
+
+/**
+ * \brief           Get memory usage and fragmentation statistics
+ *
+ *                  Function walks over all blocks, time depends on number of blocks in memory
+ *
+ * \note            This function is private and may be called only when OS protection is active
+ * \param[out]      stats: Pointer to statistics to fill
+ * \param[in]       region: Index of region to get statistics for or \ref GUI_MEM_REGION_ALL for all regions
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_mem_getstats(gui_mem_stats_t* stats, size_t region) {
+    mem_statsctx_t ctx;
+    
+    if (stats == NULL || (region != GUI_MEM_REGION_ALL && region >= MemRegionsCount)) {
+        return 0;
+    }
+    
+    memset(stats, 0x00, sizeof(*stats));
+    MEM_PROTECT();                                  /* Counters and blocks must be consistent */
+    if (region == GUI_MEM_REGION_ALL) {
+        stats->total = MemTotalSize;
+        stats->free = MemAvailableBytes;
+        stats->max_used = MemTotalSize - MemMinAvailableBytes;
+    } else {
+        stats->total = MemRegions[region].total;
+        stats->free = MemRegions[region].total - MemRegions[region].used;
+        stats->max_used = MemRegions[region].max_used;
+    }
+    stats->used = stats->total - stats->free;
+    
+    ctx.stats = stats;
+    ctx.region = region;
+    mem_walk(mem_stats_block, &ctx);
+    MEM_UNPROTECT();
+    if (stats->free > 0) {
+        stats->fragmentation = 1.0f - (float)stats->largest_free / (float)stats->free;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Call function for every memory block, allocated or free, in address order of each region
+ * \note            This function is private and may be called only when OS protection is active.
+ *                  Memory must not be allocated or freed in callback function
+ * \param[in]       fn: Function to call for every block. It returns `1` to continue or `0` to stop the walk
+ * \param[in]       arg: Custom user argument passed to callback function
+ * \return          `1` when all blocks were walked, `0` when walk was stopped or function is invalid
+ */
+uint8_t
+gui_mem_walk(gui_mem_walk_fn fn, void* arg) {
+    uint8_t ret;
+    
+    if (fn == NULL) {
+        return 0;
+    }
+    MEM_PROTECT();
+    ret = mem_walk(fn, arg);
+    MEM_UNPROTECT();
+    return ret;
+}
+
+/**
+ * \brief           Write compact binary dump of memory layout for offline analysis
+ *
+ *                  All values are 32-bit little endian. Dump has header, followed by every region
+ *                  and its blocks in address order:
+ *
+ *                  - Header: characters `GMEM`, version (`1`, 1 byte), algorithm (`0` for first-fit, `1` for TLSF, 1 byte),
+ *                      number of regions (2 bytes), total bytes, minimal free bytes ever
+ *                  - Region: start address, total bytes, maximal bytes ever used, number of blocks
+ *                  - Block: size of block including header, top bit is set when block is allocated
+ *
+ * \note            This function is private and may be called only when OS protection is active
+ * \param[out]      buff: Buffer to write dump to. Set to `NULL` to get required length only
+ * \param[in]       len: Length of buffer in units of bytes. When too short, only first `len` bytes are written
+ * \return          Length of complete dump in units of bytes
+ */
+size_t
+gui_mem_dump(void* buff, size_t len) {
+    mem_dumpctx_t ctx;
+    size_t i;
+    
+    ctx.buff = buff;
+    ctx.len = buff != NULL ? len : 0;
+    ctx.pos = 0;
+    MEM_PROTECT();                                  /* Counters and blocks must be consistent */
+    mem_dump_u32(&ctx, 0x4D454D47UL);              /* "GMEM" */
+    mem_dump_u32(&ctx, 0x01UL | ((uint32_t)GUI_CFG_MEM_TLSF << 8) | ((uint32_t)MemRegionsCount << 16));
+    mem_dump_u32(&ctx, (uint32_t)MemTotalSize);
+    mem_dump_u32(&ctx, (uint32_t)MemMinAvailableBytes);
+    for (i = 0; i < MemRegionsCount; i++) {
+        ctx.count = 0;
+        mem_walkregion(&MemRegions[i], i, mem_dump_count, &ctx);
+        mem_dump_u32(&ctx, (uint32_t)(size_t)MemRegions[i].start);
+        mem_dump_u32(&ctx, (uint32_t)MemRegions[i].total);
+        mem_dump_u32(&ctx, (uint32_t)MemRegions[i].max_used);
+        mem_dump_u32(&ctx, (uint32_t)ctx.count);
+        mem_walkregion(&MemRegions[i], i, mem_dump_block, &ctx);
+    }
+    MEM_UNPROTECT();
+    return ctx.pos;
+}
+
+#if GUI_CFG_FRAME_ARENA_SIZE > 0 || __DOXYGEN__
+static size_t FrameArena[(GUI_CFG_FRAME_ARENA_SIZE + sizeof(size_t) - 1) / sizeof(size_t)];  /* Frame arena memory, aligned to size_t */
+static size_t FrameArenaTop = 0;                    /* Number of used bytes in arena */
+static size_t FrameArenaLast = 0;                   /* Offset of last allocation or `0` if none */
+static size_t FrameArenaMaxUsed = 0;                /* Maximal number of bytes ever used in arena */
+#endif /* GUI_CFG_FRAME_ARENA_SIZE > 0 || __DOXYGEN__ */
+
+/**
+ * \brief           Allocate transient memory valid until the end of current redraw
+ *
+ *                  Memory is taken from frame arena with pointer increment, it never fragments general memory.
+ *                  When arena is full, memory is allocated with \ref gui_mem_alloc instead.
+ *                  Memory is not set to zero
+ *
+ * \note            This function is private and may be called only when OS protection is active
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Allocated memory on success, `NULL` otherwise
+ * \sa              gui_frame_free
+ */
+void*
+gui_frame_alloc(size_t size) {
+#if GUI_CFG_FRAME_ARENA_SIZE > 0
+    uint8_t* base = (uint8_t *)FrameArena;
+    size_t start;
+    
+    /* Every allocation starts with offset of previous one, to release them in reverse order */
+    start = (size_t)(base + FrameArenaTop + sizeof(size_t));
+    start = ((start + (MEM_ALIGN_NUM - 1)) & ~(MEM_ALIGN_NUM - 1)) - (size_t)base;
+    if (size > 0 && size <= sizeof(FrameArena) && start <= sizeof(FrameArena) - size) {
+        memcpy(base + start - sizeof(size_t), &FrameArenaLast, sizeof(size_t));
+        FrameArenaLast = start;
+        FrameArenaTop = start + size;
+        if (FrameArenaTop > FrameArenaMaxUsed) {
+            FrameArenaMaxUsed = FrameArenaTop;
+        }
+        return base + start;
+    }
+#endif /* GUI_CFG_FRAME_ARENA_SIZE > 0 */
+    return gui_mem_alloc(size);                     /* Arena is full, use general memory */
+}
+
+/**
+ * \brief           Free memory allocated with \ref gui_frame_alloc
+ *
+ *                  Memory of last arena allocation is immediately available again,
+ *                  other arena memory is released at the end of redraw
+ *
+ * \note            This function is private and may be called only when OS protection is active
+ * \param[in]       ptr: Pointer to memory to free
+ */
+void
+gui_frame_free(void* ptr) {
+#if GUI_CFG_FRAME_ARENA_SIZE > 0
+    uint8_t* base = (uint8_t *)FrameArena;
+    
+    if ((uint8_t *)ptr >= base && (uint8_t *)ptr < base + sizeof(FrameArena)) {
+        if ((uint8_t *)ptr == base + FrameArenaLast) {  /* Release last allocation now */
+            FrameArenaTop = FrameArenaLast - sizeof(size_t);
+            memcpy(&FrameArenaLast, base + FrameArenaTop, sizeof(size_t));
+        }
+        return;
+    }
+#endif /* GUI_CFG_FRAME_ARENA_SIZE > 0 */
+    gui_mem_free(ptr);
+}
+
+/**
+ * \brief           Get maximal number of bytes ever used in frame arena
+ *
+ *                  Use it to tune \ref GUI_CFG_FRAME_ARENA_SIZE configuration
+ *
+ * \return          Number of bytes
+ */
+size_t
+gui_frame_getmaxused(void) {
+#if GUI_CFG_FRAME_ARENA_SIZE > 0
+    return FrameArenaMaxUsed;
+#else /* GUI_CFG_FRAME_ARENA_SIZE > 0 */
+    return 0;
+#endif /* !(GUI_CFG_FRAME_ARENA_SIZE > 0) */
+}
+
+/**
+ * \brief           Release all frame arena memory
+ * \note            Called by GUI stack at the end of every redraw
+ */
+void
+guii_frame_reset(void) {
+#if GUI_CFG_FRAME_ARENA_SIZE > 0
+    FrameArenaTop = 0;
+    FrameArenaLast = 0;
+#endif /* GUI_CFG_FRAME_ARENA_SIZE > 0 */
+}
+
+#if GUI_CFG_USE_MEM_POOL || __DOXYGEN__
+/**
+ * \brief           Pool of objects of the same size
+ *
+ *                  Free objects are linked together with pointer in their first bytes,
+ *                  allocated objects have no header
+ */
+typedef struct {
+    size_t size;                                    /*!< Size of single object, aligned */
+    void* free;                                     /*!< First free object */
+    size_t used;                                    /*!< Number of allocated objects */
+} mem_pool_t;
+
+static mem_pool_t MemPools[GUI_CFG_MEM_POOL_CLASSES];   /* Pools for all object sizes */
+static size_t MemPoolsCount = 0;                    /* Number of pools in use */
+
+/**
+ * \brief           Get pool for object size
+ * \param[in]       size: Size of object
+ * \param[in]       create: Set to `1` to create new pool if it does not exist yet
+ * \return          Pool on success, `NULL` otherwise
+ */
+static mem_pool_t*
+mem_pool_get(size_t size, uint8_t create) {
+    size_t i;
+    
+    /* Object must be able to hold pointer to next free object */
+    size = GUI_MEM_ALIGN((size + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *));
+    for (i = 0; i < MemPoolsCount; i++) {
+        if (MemPools[i].size == size) {
+            return &MemPools[i];
+        }
+    }
+    if (!create || MemPoolsCount == GUI_CFG_MEM_POOL_CLASSES) {
+        return NULL;
+    }
+    MemPools[MemPoolsCount].size = size;
+    return &MemPools[MemPoolsCount++];
+}
+#endif /* GUI_CFG_USE_MEM_POOL || __DOXYGEN__ */
+
+/**
+ * \brief           Allocate object from object pool of its size and set it to zero
+ *
+ *                  Objects are taken from slabs in address order, objects allocated one
+ *                  after another are close together in memory
+ *
+ * \note            This function is private and may be called only when OS protection is active
+ * \param[in]       size: Size of object in units of bytes
+ * \return          Allocated object on success, `NULL` otherwise
+ * \sa              gui_mem_pool_free
+ */
+void*
+gui_mem_pool_alloc(size_t size) {
+#if GUI_CFG_USE_MEM_POOL
+    mem_pool_t* pool;
+    uint8_t* slab;
+    void* ptr;
+    size_t i;
+    
+    if (size > 0 && (pool = mem_pool_get(size, 1)) != NULL) {
+        if (pool->free == NULL) {                   /* Pool is empty, add new slab */
+            slab = gui_mem_allocex(pool->size * GUI_CFG_MEM_POOL_SLAB_OBJECTS, GUI_MEM_CLASS_FAST);
+            if (slab == NULL) {
+                return NULL;
+            }
+            for (i = 0; i < GUI_CFG_MEM_POOL_SLAB_OBJECTS; i++) {   /* Link objects in address order */
+                *(void **)(slab + i * pool->size) = i + 1 < GUI_CFG_MEM_POOL_SLAB_OBJECTS ? slab + (i + 1) * pool->size : NULL;
+            }
+            pool->free = slab;
+        }
+        ptr = pool->free;
+        pool->free = *(void **)ptr;
+        pool->used++;
+        memset(ptr, 0x00, pool->size);
+        return ptr;
+    }
+#endif /* GUI_CFG_USE_MEM_POOL */
+    return gui_mem_calloc(1, size);
+}
+
+/**
+ * \brief           Free object previously allocated with \ref gui_mem_pool_alloc
+ *
+ *                  Object is returned to its pool and is used for next object of the same size
+ *
+ * \note            This function is private and may be called only when OS protection is active
+ * \param[in]       ptr: Pointer to object
+ * \param[in]       size: Size of object, the same as used for allocation
+ */
+void
+gui_mem_pool_free(void* ptr, size_t size) {
+#if GUI_CFG_USE_MEM_POOL
+    mem_pool_t* pool;
+    
+    if (ptr != NULL && (pool = mem_pool_get(size, 0)) != NULL) {
+        *(void **)ptr = pool->free;
+        pool->free = ptr;
+        pool->used--;
+        return;
+    }
+#else /* GUI_CFG_USE_MEM_POOL */
+    GUI_UNUSED(size);
+#endif /* !GUI_CFG_USE_MEM_POOL */
+    gui_mem_free(ptr);
+}
+
+/**
+ * \brief           Get number of allocated objects in object pool
+ * \param[in]       size: Size of objects in pool
+ * \return          Number of allocated objects
+ */
+size_t
+gui_mem_pool_getused(size_t size) {
+#if GUI_CFG_USE_MEM_POOL
+    mem_pool_t* pool = mem_pool_get(size, 0);
+    
+    return pool != NULL ? pool->used : 0;
+#else /* GUI_CFG_USE_MEM_POOL */
+    GUI_UNUSED(size);
+    return 0;
+#endif /* !GUI_CFG_USE_MEM_POOL */
+}
+
+/**
+ * \brief           Initialize magazine for blocks of specific size
+ *
+ *                  Magazine belongs to one thread and must not be used by other threads.
+ *                  Blocks from magazine are normal memory blocks, any thread may free them with \ref gui_mem_free
+ *
+ * \param[in]       mag: Magazine to initialize
+ * \param[in]       size: Size of every block in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_mem_magazine_init(gui_mem_magazine_t* mag, size_t size) {
+    if (mag == NULL || !size) {
+        return 0;
+    }
+    memset(mag, 0x00, sizeof(*mag));
+    mag->size = size;
+    return 1;
+}
+
+/**
+ * \brief           Allocate block from magazine
+ *
+ *                  When magazine is empty, half of it is filled at once, with single
+ *                  acquisition of memory manager protection
+ *
+ * \param[in]       mag: Magazine of calling thread
+ * \return          Allocated memory on success, `NULL` otherwise. Memory is not set to zero
+ */
+void*
+gui_mem_magazine_alloc(gui_mem_magazine_t* mag) {
+    void* ptr;
+    
+    if (!mag->count) {                              /* Refill magazine */
+        MEM_PROTECT();
+        while (mag->count < (GUI_CFG_MEM_MAGAZINE_SIZE + 1) / 2) {
+            if ((ptr = gui_mem_alloc(mag->size)) == NULL) {
+                break;
+            }
+            mag->blocks[mag->count++] = ptr;
+        }
+        MEM_UNPROTECT();
+        if (!mag->count) {
+            return NULL;
+        }
+    }
+    return mag->blocks[--mag->count];
+}
+
+/**
+ * \brief           Return block to magazine
+ *
+ *                  When magazine is full, half of blocks are freed at once, with single
+ *                  acquisition of memory manager protection
+ *
+ * \param[in]       mag: Magazine of calling thread
+ * \param[in]       ptr: Block of magazine size, allocated by any thread
+ */
+void
+gui_mem_magazine_free(gui_mem_magazine_t* mag, void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    if (mag->count == GUI_CFG_MEM_MAGAZINE_SIZE) {  /* Flush half of magazine */
+        MEM_PROTECT();
+        while (mag->count > GUI_CFG_MEM_MAGAZINE_SIZE / 2) {
+            gui_mem_free(mag->blocks[--mag->count]);
+        }
+        MEM_UNPROTECT();
+    }
+    mag->blocks[mag->count++] = ptr;
+}
+
+/**
+ * \brief           Free all blocks cached in magazine
+ * \param[in]       mag: Magazine of calling thread
+ */
+void
+gui_mem_magazine_flush(gui_mem_magazine_t* mag) {
+    MEM_PROTECT();
+    while (mag->count > 0) {
+        gui_mem_free(mag->blocks[--mag->count]);
+    }
+    MEM_UNPROTECT();
+}
+
 /**
  * \brief           Assign memory region(s) for allocation functions
- * \note            You can allocate multiple regions by assigning start address and region size in units of bytes
+ * \note            You can allocate multiple regions by assigning start address and region size in units of bytes.
+ *                  Set memory classes of region to place allocations with \ref gui_mem_allocex to proper memory
  * \param[in]       regions: Pointer to list of regions to use for allocations
  * \param[in]       len: Number of regions to use
  * \return          `1` on success, `0` otherwise
@@ -464,7 +1646,14 @@ uint8_t
 gui_mem_assignmemory(const gui_mem_region_t* regions, size_t len) {
     uint8_t ret;
     
+#if GUI_CFG_OS && GUI_CFG_MEM_THREADSAFE
+    if (!MemMutexValid) {                           /* Regions are assigned during initialization, before other threads use memory */
+        MemMutexValid = gui_sys_mutex_create(&MemMutex);
+    }
+#endif /* GUI_CFG_OS && GUI_CFG_MEM_THREADSAFE */
+    MEM_PROTECT();
     ret = mem_assignmem(regions, len);              /* Assign memory */
+    MEM_UNPROTECT();
 
     return ret;                                     
 }
@@ -114,7 +114,7 @@ gui_text_createcharentry(const gui_font_t* font, const gui_font_char_t* c) {
     memsize = GUI_MEM_ALIGN(sizeof(*entry));
     memDataSize = (size_t)c->x_size * (size_t)c->y_size;
     memsize += GUI_MEM_ALIGN(memDataSize);          /* Align memory before increase */
-    entry = GUI_MEMALLOC(memsize);                  /* Allocate memory for entry */
+    entry = GUI_MEMALLOC_CLASS(memsize, GUI_MEM_CLASS_FAST);    /* Allocate memory for entry, it is read on every character draw */
     if (entry != NULL) {                            /* Allocation was successful */
         uint16_t i, x;
         uint8_t b, k, t;
@@ -41,6 +41,9 @@
 
 #define guii_timer_isperiodic(t)        ((t)->flags & GUI_FLAG_TIMER_PERIODIC)
 
+/* Get timer reload value, doubled when timers are degraded by adaptive quality */
+#define guii_timer_getreload(t)         (guii_quality_isdegraded(GUI_QUALITY_DEGRADE_TIMER) ? (uint16_t)GUI_MIN(0xFFFFUL, 2UL * (t)->period) : (t)->period)
+
 /**
  * \brief           Create new software timer
  * \note            This function is private and may be called only when OS protection is active
@@ -188,7 +191,7 @@ guii_timer_process(void) {
         if (t->counter >= diff) {                   /* Decrease counter value by zero */
             t->counter -= diff;                     /* Try to decrease to 0 */
             if (!t->counter) {
-                t->counter = t->period;             /* Set new period value */
+                t->counter = guii_timer_getreload(t);   /* Set new period value */
                 t->flags |= GUI_FLAG_TIMER_CALL;    /* Set flag for timer callback next time */
             }
         } else {                                    /* Overflow mode */
@@ -97,6 +97,15 @@ extern "C" {
  */
 #define GUI_MEMALLOC(size)         gui_mem_calloc(1, size)
 
+/**
+ * \brief           Allocate memory with specific size in bytes from regions of requested memory classes
+ * \note            This function must take care of reseting memory to zero
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       classes: Memory classes, \ref GUI_MEM_CLASS
+ * \hideinitializer
+ */
+#define GUI_MEMALLOC_CLASS(size, classes)   gui_mem_callocex(1, size, classes)
+
 /**
  * \brief           Reallocate memory with specific size in bytes
  * \hideinitializer
@@ -112,6 +121,24 @@ extern "C" {
     (p) = NULL;                                     \
 } while (0)
 
+/**
+ * \brief           Allocate object of specific size from object pool and set it to zero
+ * \note            Object must be freed with \ref GUI_POOLFREE with the same size
+ * \hideinitializer
+ */
+#define GUI_POOLALLOC(size)         gui_mem_pool_alloc(size)
+
+/**
+ * \brief           Free object previously allocated with \ref GUI_POOLALLOC
+ * \param[in]       p: Pointer to object
+ * \param[in]       size: Size of object, the same as used for allocation
+ * \hideinitializer
+ */
+#define GUI_POOLFREE(p, size)   do {                \
+    gui_mem_pool_free(p, size);                     \
+    (p) = NULL;                                     \
+} while (0)
+
 /**
  * \brief           Get maximal value between 2 values
  * \param[in]       x: First value
@@ -193,6 +220,13 @@ guir_t      gui_init(void);
 int32_t     gui_process(void);
 uint8_t     gui_seteventcallback(gui_eventcallback_t cb);
 
+#if GUI_CFG_USE_ADAPTIVE_QUALITY || __DOXYGEN__
+uint8_t     gui_quality_setpolicy(gui_quality_policy_fn policy);
+uint8_t     gui_quality_setdegrade(uint32_t degrade);
+uint32_t    gui_quality_getdegrade(void);
+uint32_t    gui_quality_getpainttime(void);
+#endif /* GUI_CFG_USE_ADAPTIVE_QUALITY || __DOXYGEN__ */
+
 #if GUI_CFG_OS || __DOXYGEN__
 uint8_t     gui_protect(const uint8_t protect);
 uint8_t     gui_unprotect(const uint8_t unprotect);
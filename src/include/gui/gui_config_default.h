@@ -103,6 +103,33 @@
 #define GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE   1
 #endif
 
+/**
+ * \brief           Enables (1) or disables (0) cache of decimated graph plots
+ *
+ *                  YT plot samples are decimated to minimal and maximal value per screen column.
+ *                  When enabled, decimated columns are kept with each data object and reused
+ *                  until data or visible area changes, thus redraw depends only on graph width
+ *
+ * \note            It requires additional memory of about `10` bytes per graph column for every data object
+ */
+#ifndef GUI_CFG_WIDGET_GRAPH_DATA_CACHE
+#define GUI_CFG_WIDGET_GRAPH_DATA_CACHE         0
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) retained plot area of graph widgets
+ *
+ *                  When enabled, plot area of each graph is kept in virtual layer.
+ *                  When plot moves because of new YT samples or touch panning,
+ *                  existing pixels are moved and only newly exposed part of plot is drawn.
+ *                  Plot is copied to drawing layer with \ref gui_ll_t.Copy function
+ *
+ * \note            It requires additional memory of plot area size for every graph widget
+ */
+#ifndef GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT
+#define GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT        0
+#endif
+
 /**
  * \brief           Enables (1) or disables (0) widget mode inside parent only
  *                  
@@ -147,6 +174,85 @@
 #define GUI_CFG_MEM_ALIGNMENT                   4
 #endif
 
+/**
+ * \brief           Enables (1) or disables (0) two-level segregated fit algorithm for library allocator
+ *
+ *                  When enabled, allocation and free take constant time regardless of heap fragmentation
+ *                  and reallocation grows memory in place when free memory follows allocated block.
+ *                  Every region keeps its own free lists at the beginning of region memory.
+ *                  When disabled, first-fit algorithm over address ordered free list is used
+ *
+ * \note            Used only when \ref GUI_CFG_USE_MEM is enabled
+ */
+#ifndef GUI_CFG_MEM_TLSF
+#define GUI_CFG_MEM_TLSF                        0
+#endif
+
+/**
+ * \brief           Maximal number of memory regions for \ref gui_mem_assignmemory function
+ */
+#ifndef GUI_CFG_MEM_MAX_REGIONS
+#define GUI_CFG_MEM_MAX_REGIONS                 4
+#endif
+
+/**
+ * \brief           Size of frame arena for transient allocations during drawing, in units of bytes
+ *
+ *                  Memory returned by \ref gui_frame_alloc is taken from this fixed block by pointer increment
+ *                  and is released all at once at the end of every redraw.
+ *                  When arena is full or size is set to `0`, allocations use general memory manager instead
+ */
+#ifndef GUI_CFG_FRAME_ARENA_SIZE
+#define GUI_CFG_FRAME_ARENA_SIZE                0
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) object pools for widgets and internal list nodes
+ *
+ *                  When enabled, objects of the same size are taken from slabs of \ref GUI_CFG_MEM_POOL_SLAB_OBJECTS objects,
+ *                  without block header per object. Slabs are kept for later objects of the same size when objects are freed.
+ *                  When disabled, every object is allocated with general memory manager
+ */
+#ifndef GUI_CFG_USE_MEM_POOL
+#define GUI_CFG_USE_MEM_POOL                    0
+#endif
+
+/**
+ * \brief           Maximal number of different object sizes with own pool
+ *
+ *                  Objects of other sizes are allocated with general memory manager
+ */
+#ifndef GUI_CFG_MEM_POOL_CLASSES
+#define GUI_CFG_MEM_POOL_CLASSES                16
+#endif
+
+/**
+ * \brief           Number of objects allocated together in single slab of object pool
+ */
+#ifndef GUI_CFG_MEM_POOL_SLAB_OBJECTS
+#define GUI_CFG_MEM_POOL_SLAB_OBJECTS           8
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) own protection of memory manager
+ *
+ *                  When enabled, memory manager uses its own mutex instead of GUI core protection.
+ *                  Other threads may then allocate and free memory with \ref gui_mem_alloc, \ref gui_mem_free
+ *                  and \ref gui_mem_magazine_alloc functions without holding GUI core protection
+ *
+ * \note            Used only when \ref GUI_CFG_OS is enabled
+ */
+#ifndef GUI_CFG_MEM_THREADSAFE
+#define GUI_CFG_MEM_THREADSAFE                  0
+#endif
+
+/**
+ * \brief           Maximal number of objects cached in single \ref gui_mem_magazine_t
+ */
+#ifndef GUI_CFG_MEM_MAGAZINE_SIZE
+#define GUI_CFG_MEM_MAGAZINE_SIZE               16
+#endif
+
 /**
  * \brief           Enables (1) or disables (0) alpha option for widgets
  *
@@ -156,6 +262,18 @@
 #define GUI_CFG_USE_ALPHA                      0
 #endif
 
+/**
+ * \brief           Enables (1) or disables (0) anti-aliased edge of filled circles
+ *
+ *                  When enabled, edge pixels of filled circles, circle corners and rounded rectangles
+ *                  are blended with background according to their coverage
+ *
+ * \note            Blending requires reading pixels from drawing layer
+ */
+#ifndef GUI_CFG_USE_CIRCLE_AA
+#define GUI_CFG_USE_CIRCLE_AA                   0
+#endif
+
 /**
  * \brief           Enables (1) or disables (0) widgets' position and size cache
  *
@@ -179,6 +297,64 @@
 #define GUI_CFG_USE_POS_SIZE_CACHE              0
 #endif
 
+/**
+ * \brief           Enables (1) or disables (0) lazy allocation of rarely used widget values
+ *
+ *                  Text, font, timer, custom colors, scroll, padding, z-index and user data of widget
+ *                  are kept in \ref gui_handle_ext_t structure, out of values used on every widget tree traversal.
+ *
+ *                  When enabled, structure is allocated on first change of any of these values
+ *                  and widgets with default values use less memory. When disabled, structure is part of every widget
+ *
+ * \note            When enabled, widget without own values uses current default font, set with \ref gui_widget_setfontdefault
+ */
+#ifndef GUI_CFG_WIDGET_LAZY_EXT
+#define GUI_CFG_WIDGET_LAZY_EXT                 0
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) arrays of children widgets instead of linked lists
+ *
+ *                  When enabled, every parent widget keeps its children in growable array of handles,
+ *                  ordered the same way as on linked list. Widget tree traversal reads consecutive memory,
+ *                  access by index is constant time and z-index reorder is done with single memory move.
+ *
+ * \note            Array is allocated from memory with \ref GUI_MEM_CLASS_FAST class if available
+ *                  and grows when children widgets are added
+ */
+#ifndef GUI_CFG_WIDGET_CHILD_ARRAY
+#define GUI_CFG_WIDGET_CHILD_ARRAY              0
+#endif
+
+/**
+ * \brief           Number of bytes for short text stored inside widget, including string termination
+ *
+ *                  When set to value greater than `0`, text memory requested with \ref gui_widget_alloctextmemory
+ *                  is stored inside widget values while text fits to this memory.
+ *                  Memory of requested size is allocated only when text becomes longer
+ *                  and is released again when shorter text is set with \ref gui_widget_settext
+ *
+ * \note            Memory is part of \ref gui_handle_ext_t structure of every widget,
+ *                  use \ref GUI_CFG_WIDGET_LAZY_EXT to keep it only for widgets with own values
+ */
+#ifndef GUI_CFG_WIDGET_TEXT_INLINE_SIZE
+#define GUI_CFG_WIDGET_TEXT_INLINE_SIZE         0
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) static widget trees
+ *
+ *                  Widget trees are described with constant tables, which can be placed to read-only memory.
+ *                  Memory for widgets of tree is taken from static memory block, see \ref GUI_WIDGET_TREE
+ *
+ * \note            Widgets may still allocate memory for their own purposes, such as timers.
+ *                  Use it with \ref GUI_CFG_WIDGET_LAZY_EXT and \ref GUI_CFG_WIDGET_CHILD_ARRAY disabled
+ *                  to avoid allocation for widget values and children lists
+ */
+#ifndef GUI_CFG_USE_WIDGET_TREE
+#define GUI_CFG_USE_WIDGET_TREE                 0
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` widget invalidate ignore after create event
  *
@@ -223,6 +399,72 @@ gui_widget_setignoreinvalidate(h, 0, 1, 0);
 #define GUI_CFG_LONG_CLICK_TIMEOUT              1500
 #endif
 
+/**
+ * \brief           Enables (1) or disables (0) adaptive rendering quality
+ *
+ *                  When enabled, paint time of every frame is measured.
+ *                  If frame takes longer than \ref GUI_CFG_ADAPTIVE_QUALITY_BUDGET,
+ *                  expensive drawing features are temporary degraded (graph plots are decimated,
+ *                  timers run slower, anti-aliased text is not blended and alpha layers are skipped).
+ *
+ *                  When GUI is idle for \ref GUI_CFG_ADAPTIVE_QUALITY_IDLE_TIME milliseconds,
+ *                  last degraded feature is restored and used when widgets are redrawn next time.
+ *                  Features are restored one by one, each after another idle period
+ *
+ * \note            Application may override default policy with \ref gui_quality_setpolicy function
+ */
+#ifndef GUI_CFG_USE_ADAPTIVE_QUALITY
+#define GUI_CFG_USE_ADAPTIVE_QUALITY            0
+#endif
+
+/**
+ * \brief           Frame paint time budget in units of milliseconds
+ *
+ *                  When redraw takes longer than this value, quality is degraded by one step
+ */
+#ifndef GUI_CFG_ADAPTIVE_QUALITY_BUDGET
+#define GUI_CFG_ADAPTIVE_QUALITY_BUDGET         20
+#endif
+
+/**
+ * \brief           Time in units of milliseconds without redraw before quality is restored by one step
+ */
+#ifndef GUI_CFG_ADAPTIVE_QUALITY_IDLE_TIME
+#define GUI_CFG_ADAPTIVE_QUALITY_IDLE_TIME      500
+#endif
+
+/**
+ * \brief           Maximal idle time in units of milliseconds before quality is restored by one step
+ *
+ *                  Every time quality is degraded again by first frame after restore,
+ *                  idle time is doubled, up to this value
+ */
+#ifndef GUI_CFG_ADAPTIVE_QUALITY_IDLE_TIME_MAX
+#define GUI_CFG_ADAPTIVE_QUALITY_IDLE_TIME_MAX  (16 * GUI_CFG_ADAPTIVE_QUALITY_IDLE_TIME)
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) time-sliced redraw
+ *
+ *                  When enabled, drawing of widgets is suspended after \ref GUI_CFG_REDRAW_SLICE_TIME
+ *                  and continued in next process call. Input events are processed between slices.
+ *
+ *                  Frame is drawn to drawing layer and shown only when all widgets are drawn,
+ *                  thus partially drawn frame is never visible on screen
+ *
+ * \note            Drawing of widget with alpha is never suspended as it uses temporary virtual layer
+ */
+#ifndef GUI_CFG_USE_REDRAW_SLICE
+#define GUI_CFG_USE_REDRAW_SLICE                0
+#endif
+
+/**
+ * \brief           Maximal time for single redraw slice in units of milliseconds
+ */
+#ifndef GUI_CFG_REDRAW_SLICE_TIME
+#define GUI_CFG_REDRAW_SLICE_TIME               10
+#endif
+
 #ifndef GUI_CFG_SYS_PORT
 #define GUI_CFG_SYS_PORT                        GUI_SYS_PORT_CMSIS_OS
 #endif
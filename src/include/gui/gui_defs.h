@@ -82,6 +82,9 @@ extern "C" {
 #define GUI_FLAG_IGNORE_INVALIDATE          ((uint32_t)0x00004000)  /*!< Indicates widget invalidation is ignored completely when invalidating it directly */
 #define GUI_FLAG_FIRST_INVALIDATE           ((uint32_t)0x00008000)  /*!< Indicates widget is invalidated for "first" time, thus ignore check if parent is hidden or not */
 #define GUI_FLAG_TOUCH_MOVE                 ((uint32_t)0x00010000)  /*!< Indicates widget callback has processed touch move event. This parameter works in conjunction with \ref GUI_FLAG_ACTIVE flag */
+#define GUI_FLAG_CHILD_REDRAW               ((uint32_t)0x00020000)  /*!< Indicates at least one of children widgets on any level should be redrawn */
+#define GUI_FLAG_DRAW_AFTER                 ((uint32_t)0x00200000)  /*!< Indicates widget drawing was suspended and \ref GUI_EVT_DRAWAFTER event is pending after children are redrawn */
+#define GUI_FLAG_STATIC_MEMORY              ((uint32_t)0x00400000)  /*!< Indicates widget memory is part of static widget tree block and is not freed on remove */
 
 /**
  * \}
@@ -104,6 +107,23 @@ extern "C" {
 
 #define GUI_FLAG_LCD_WAIT_LAYER_CONFIRM     ((uint32_t)0x00000001)  /*!< Indicates waiting for layer change confirmation */
 
+/**
+ * \anchor          GUI_FLAGS_QUALITY
+ * \name            Adaptive quality flags
+ * \brief           Drawing features which may be degraded when frame budget is exceeded
+ * \{
+ */
+
+#define GUI_QUALITY_DEGRADE_GRAPH           ((uint32_t)0x00000001)  /*!< Graph plots skip samples to reduce number of drawn lines */
+#define GUI_QUALITY_DEGRADE_TIMER           ((uint32_t)0x00000002)  /*!< Software timers run at half of their tick rate */
+#define GUI_QUALITY_DEGRADE_TEXT_AA         ((uint32_t)0x00000004)  /*!< Anti-aliased fonts are drawn without color blending */
+#define GUI_QUALITY_DEGRADE_ALPHA           ((uint32_t)0x00000008)  /*!< Widgets with alpha are drawn opaque without virtual layer */
+#define GUI_QUALITY_DEGRADE_ALL             ((uint32_t)0x0000000F)  /*!< All features degraded */
+
+/**
+ * \}
+ */
+
 /**
  * \anchor          GUI_FLAG_ALIGN
  * \name            Alignment flags
@@ -197,6 +217,16 @@ typedef struct gui_linkedlistroot {
     void* first;                            /*!< First element in linked list */
     void* last;                             /*!< Last element in linked list */
 } gui_linkedlistroot_t;
+
+/**
+ * \brief           Array of children widgets, used instead of linked list when \ref GUI_CFG_WIDGET_CHILD_ARRAY is enabled
+ * \note            Widgets are in the same order as on linked list, first widget is drawn first
+ */
+typedef struct gui_widgetarray {
+    struct gui_handle** items;              /*!< Pointer to array of widget handles */
+    uint16_t count;                         /*!< Number of widgets in array */
+    uint16_t size;                          /*!< Number of allocated entries in array */
+} gui_widgetarray_t;
  
 /**
  * \brief           Core timer structure for GUI timers
@@ -269,6 +299,15 @@ typedef struct gui_handle* gui_handle_p;
  */
 typedef void (*gui_eventcallback_t)(void);
 
+/**
+ * \brief           Adaptive quality policy function declaration
+ * \param[in]       degrade: Currently degraded features, combination of \ref GUI_FLAGS_QUALITY flags
+ * \param[in]       paint_time: Paint time of last frame in units of milliseconds
+ * \param[in]       idle: Set to `1` when called because GUI was idle, `0` when called after frame was drawn
+ * \return          New set of degraded features, combination of \ref GUI_FLAGS_QUALITY flags
+ */
+typedef uint32_t (*gui_quality_policy_fn)(uint32_t degrade, uint32_t paint_time, uint8_t idle);
+
 /**
  * \brief           Color gradient definition
  */
@@ -1128,18 +1167,51 @@ typedef struct {
 
 #if defined(GUI_INTERNAL) || __DOXYGEN__
 
+/**
+ * \brief           Rarely used values of widget
+ *
+ *                  Values are kept out of \ref gui_handle, which has only values used on every widget tree traversal
+ */
+typedef struct gui_handle_ext {
+    gui_const gui_font_t* font;             /*!< Font used for widget drawings */
+    gui_char* text;                         /*!< Pointer to widget text if exists */
+    size_t textmemsize;                     /*!< Number of bytes for text when dynamically allocated */
+    size_t textcursor;                      /*!< Text cursor position */
+#if GUI_CFG_WIDGET_TEXT_INLINE_SIZE || __DOXYGEN__
+    gui_char text_inline[GUI_CFG_WIDGET_TEXT_INLINE_SIZE];  /*!< Memory for short dynamic text, used before memory is allocated */
+#endif /* GUI_CFG_WIDGET_TEXT_INLINE_SIZE || __DOXYGEN__ */
+    gui_timer_t* timer;                     /*!< Software timer pointer */
+    gui_color_t* colors;                    /*!< Pointer to allocated color memory when custom colors are used */
+    void* arg;                              /*!< Pointer to optional user data */
+    uint32_t padding;                       /*!< 4-bytes long padding, each byte of one side, MSB = top padding, LSB = left padding.
+                                                    Used for children widgets if virtual padding should be used */
+    int32_t zindex;                         /*!< Z-Index value of widget, which can be set by user.
+                                                    All widgets with same z-index are changeable when active on visible area */
+    
+    /* Scroll feature, available only for widgets with children support */
+    gui_dim_t x_scroll;                     /*!< Scroll of widgets in horizontal direction in units of pixels */
+    gui_dim_t y_scroll;                     /*!< Scroll of widgets in vertical direction in units of pixels */
+} gui_handle_ext_t;
+
 /**
  * \brief           Common GUI values for widgets
+ *
+ *                  Values used on every widget tree traversal are on top,
+ *                  rarely used values are in \ref gui_handle_ext_t structure
  */
 typedef struct gui_handle {
+#if GUI_CFG_WIDGET_CHILD_ARRAY || __DOXYGEN__
+    gui_widgetarray_t root_list;            /*!< Array of children widgets */
+    uint16_t index;                         /*!< Position of widget in array of parent widget */
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY || __DOXYGEN__ */
     gui_linkedlist_t list;                  /*!< Linked list entry, must always be on top for casting */
     gui_linkedlistroot_t root_list;         /*!< Linked list root of children widgets */
-
-    gui_id_t id;                            /*!< Widget ID number */
+#endif /* !(GUI_CFG_WIDGET_CHILD_ARRAY || __DOXYGEN__) */
+    struct gui_handle* parent;              /*!< Pointer to parent widget */
+    uint32_t flags;                         /*!< All possible flags for specific widget */
     uint32_t footprint;                     /*!< Footprint indicates widget is valid */
     const gui_widget_t* widget;             /*!< Widget parameters with callback functions */
     gui_widget_evt_fn callback;             /*!< Callback function prototype */
-    struct gui_handle* parent;              /*!< Pointer to parent widget */
 
     float x;                                /*!< Object X position relative to parent window in units of pixel/percent */
     float y;                                /*!< Object Y position relative to parent window in units of pixel/percent */
@@ -1160,26 +1232,16 @@ typedef struct gui_handle {
     gui_dim_t abs_visible_y2;               /*!< Absolute visible bottom Y positon on screen for widget */
 #endif /* GUI_CFG_USE_POS_SIZE_CACHE */
 
-    uint32_t padding;                       /*!< 4-bytes long padding, each byte of one side, MSB = top padding, LSB = left padding.
-                                                    Used for children widgets if virtual padding should be used */
-    int32_t zindex;                         /*!< Z-Index value of widget, which can be set by user.
-                                                    All widgets with same z-index are changeable when active on visible area */
 #if GUI_CFG_USE_ALPHA || __DOXYGEN__
     uint8_t alpha;                          /*!< Widget alpha relative to parent widget */
 #endif /* GUI_CFG_USE_ALPHA */
-    uint32_t flags;                         /*!< All possible flags for specific widget */
-    gui_const gui_font_t* font;             /*!< Font used for widget drawings */
-    gui_char* text;                         /*!< Pointer to widget text if exists */
-    size_t textmemsize;                     /*!< Number of bytes for text when dynamically allocated */
-    size_t textcursor;                      /*!< Text cursor position */
-    gui_timer_t* timer;                     /*!< Software timer pointer */
-    gui_color_t* colors;                    /*!< Pointer to allocated color memory when custom colors are used */
-    
-    /* Scroll feature, available only for widgets with children support */
-    gui_dim_t x_scroll;                     /*!< Scroll of widgets in horizontal direction in units of pixels */
-    gui_dim_t y_scroll;                     /*!< Scroll of widgets in vertical direction in units of pixels */
-    
-    void* arg;                              /*!< Pointer to optional user data */
+    gui_id_t id;                            /*!< Widget ID number */
+
+#if GUI_CFG_WIDGET_LAZY_EXT || __DOXYGEN__
+    gui_handle_ext_t* ext;                  /*!< Rarely used values, allocated on first change. Use \ref guii_widget_ext to read them */
+#else /* GUI_CFG_WIDGET_LAZY_EXT || __DOXYGEN__ */
+    gui_handle_ext_t ext;                   /*!< Rarely used values */
+#endif /* !(GUI_CFG_WIDGET_LAZY_EXT || __DOXYGEN__) */
 } gui_handle;
 #endif /* defined(GUI_INTERNAL) || __DOXYGEN__ */
 
@@ -207,7 +207,7 @@ typedef enum {
 
 /**
  * \brief           Poly line object coordinates
- * \sa              gui_draw_poly
+ * \sa              gui_draw_poly, gui_draw_filledpoly, gui_draw_polyline
  */
 typedef struct {
     gui_dim_t x;                           /*!< Poly point X location */
@@ -236,6 +236,8 @@ void        gui_draw_image(gui_display_t* disp, gui_dim_t x, gui_dim_t y, const
 void        gui_draw_writetext(const gui_display_t* disp, const gui_font_t* font, const gui_char* str, gui_draw_text_t* draw);
 void        gui_draw_rectangle3d(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_draw_3d_state_t state);
 void        gui_draw_poly(const gui_display_t* disp, const gui_draw_poly_t* points, size_t len, gui_color_t color);
+void        gui_draw_polyline(const gui_display_t* disp, const gui_draw_poly_t* points, size_t len, gui_color_t color);
+void        gui_draw_filledpoly(const gui_display_t* disp, const gui_draw_poly_t* points, size_t len, gui_color_t color);
 void        gui_draw_scrollbar_init(gui_draw_sb_t* sb);
 void        gui_draw_scrollbar(const gui_display_t* disp, gui_draw_sb_t* sb);
 
@@ -98,7 +98,11 @@ uint8_t                 gui_linkedlist_multi_find_remove(gui_linkedlistroot_t* c
  * \return          `1` on success, `0` otherwise
  * \hideinitializer
  */
+#if GUI_CFG_WIDGET_CHILD_ARRAY
+#define gui_linkedlist_iswidgetfirst(h)       ((h) == NULL || gui_linkedlist_widgetgetprev(NULL, (h)) == NULL)
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY */
 #define gui_linkedlist_iswidgetfirst(h)       ((h) == NULL || (h)->list.prev == NULL)
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
 
 /**
  * \brief           Check if widget is last child element in linked list
@@ -107,14 +111,19 @@ uint8_t                 gui_linkedlist_multi_find_remove(gui_linkedlistroot_t* c
  * \return          `1` on success, `0` otherwise
  * \hideinitializer
  */
+#if GUI_CFG_WIDGET_CHILD_ARRAY
+#define gui_linkedlist_iswidgetlast(h)        ((h) == NULL || gui_linkedlist_widgetgetnext(NULL, (h)) == NULL)
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY */
 #define gui_linkedlist_iswidgetlast(h)        ((h) == NULL || (h)->list.next == NULL)
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
 
-void            gui_linkedlist_widgetadd(gui_handle_p parent, gui_handle_p h);
+uint8_t         gui_linkedlist_widgetadd(gui_handle_p parent, gui_handle_p h);
 void            gui_linkedlist_widgetremove(gui_handle_p h);
 uint8_t         gui_linkedlist_widgetmoveup(gui_handle_p h);
 uint8_t         gui_linkedlist_widgetmovedown(gui_handle_p h);
 gui_handle_p    gui_linkedlist_widgetgetnext(gui_handle_p parent, gui_handle_p h);
 gui_handle_p    gui_linkedlist_widgetgetprev(gui_handle_p parent, gui_handle_p h);
+gui_handle_p    gui_linkedlist_widgetgetbyindex(gui_handle_p parent, uint16_t index);
 uint8_t         gui_linkedlist_widgetmovetobottom(gui_handle_p h);
 uint8_t         gui_linkedlist_widgetmovetotop(gui_handle_p h);
 
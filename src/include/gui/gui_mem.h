@@ -47,12 +47,30 @@ extern "C" {
  * \{
  */
 
+/**
+ * \anchor          GUI_MEM_CLASS
+ * \name            Memory classes
+ * \brief           Classes of memory regions, used to place allocations to proper memory
+ * \{
+ */
+
+#define GUI_MEM_CLASS_ANY               ((uint32_t)0x00000000)  /*!< Any memory, region without classes is general memory */
+#define GUI_MEM_CLASS_FAST              ((uint32_t)0x00000001)  /*!< Fast memory, such as internal SRAM or DTCM */
+#define GUI_MEM_CLASS_BULK              ((uint32_t)0x00000002)  /*!< Big memory for large buffers, such as external SDRAM */
+#define GUI_MEM_CLASS_DMA               ((uint32_t)0x00000004)  /*!< Memory accessible by DMA and graphics accelerator */
+#define GUI_MEM_CLASS_STRICT            ((uint32_t)0x80000000)  /*!< Allocation flag to use only regions with all requested classes */
+
+/**
+ * \}
+ */
+
 /**
  * \brief           Single memory region descriptor
  */
 typedef struct mem_region_t {
     void* start_address;                /*!< Start address of region */
     size_t size;                        /*!< Size in units of bytes of region */
+    uint32_t classes;                   /*!< Memory classes of region, \ref GUI_MEM_CLASS. Set to `0` for general memory */
 } mem_region_t;
 
 /**
@@ -60,15 +78,92 @@ typedef struct mem_region_t {
  */
 typedef mem_region_t gui_mem_region_t;
 
+/**
+ * \brief           Number of free block size classes in \ref gui_mem_stats_t
+ */
+#define GUI_MEM_STATS_CLASSES           8
+
+/**
+ * \brief           Region index to get statistics for all regions together
+ */
+#define GUI_MEM_REGION_ALL              ((size_t)-1)
+
+/**
+ * \brief           Memory usage and fragmentation statistics
+ */
+typedef struct {
+    size_t total;                       /*!< Number of bytes available for allocation when memory is empty */
+    size_t used;                        /*!< Number of bytes currently allocated, including block headers */
+    size_t max_used;                    /*!< Maximal number of bytes ever allocated (high-water mark) */
+    size_t free;                        /*!< Number of free bytes */
+    size_t largest_free;                /*!< Size of largest free block, including block header */
+    size_t used_blocks;                 /*!< Number of allocated blocks */
+    size_t free_blocks;                 /*!< Number of free blocks */
+    float fragmentation;                /*!< Part of free memory not in largest free block, from `0` (not fragmented) to `1` */
+    size_t free_histogram[GUI_MEM_STATS_CLASSES];   /*!< Number of free blocks per size class. Class `i` has blocks smaller than `32 << i` bytes,
+                                                        last class has all bigger blocks */
+} gui_mem_stats_t;
+
+/**
+ * \brief           Memory block information for \ref gui_mem_walk function
+ */
+typedef struct {
+    void* address;                      /*!< Address of user memory in block */
+    size_t size;                        /*!< Size of block in units of bytes, including block header */
+    size_t region;                      /*!< Index of region block is in */
+    uint8_t used;                       /*!< Set to `1` when block is allocated, `0` when free */
+} gui_mem_block_t;
+
+/**
+ * \brief           Callback function for \ref gui_mem_walk function
+ * \param[in]       block: Information about block
+ * \param[in]       arg: Custom user argument
+ * \return          `1` to continue walking, `0` to stop
+ */
+typedef uint8_t (*gui_mem_walk_fn)(const gui_mem_block_t* block, void* arg);
+
+/**
+ * \brief           Cache of memory blocks of the same size, owned by single thread
+ *
+ *                  Blocks are taken from and returned to memory manager in batches,
+ *                  other operations don't need any protection
+ */
+typedef struct {
+    size_t size;                        /*!< Size of every block in units of bytes */
+    size_t count;                       /*!< Number of cached blocks */
+    void* blocks[GUI_CFG_MEM_MAGAZINE_SIZE];    /*!< Cached blocks */
+} gui_mem_magazine_t;
+
 void* gui_mem_alloc(uint32_t size);
 void* gui_mem_realloc(void* ptr, size_t size);
 void* gui_mem_calloc(size_t num, size_t size);
+void* gui_mem_allocex(size_t size, uint32_t classes);
+void* gui_mem_callocex(size_t num, size_t size, uint32_t classes);
 void gui_mem_free(void* ptr);
 size_t gui_mem_getfree(void);
 size_t gui_mem_getfull(void);
 size_t gui_mem_getminfree(void);
+size_t gui_mem_getlargestfree(void);
+size_t gui_mem_getregioncount(void);
+uint8_t gui_mem_getstats(gui_mem_stats_t* stats, size_t region);
+uint8_t gui_mem_walk(gui_mem_walk_fn fn, void* arg);
+size_t gui_mem_dump(void* buff, size_t len);
 
 uint8_t gui_mem_assignmemory(const gui_mem_region_t* regions, size_t size);
+
+void* gui_frame_alloc(size_t size);
+void gui_frame_free(void* ptr);
+size_t gui_frame_getmaxused(void);
+void guii_frame_reset(void);
+
+void* gui_mem_pool_alloc(size_t size);
+void gui_mem_pool_free(void* ptr, size_t size);
+size_t gui_mem_pool_getused(size_t size);
+
+uint8_t gui_mem_magazine_init(gui_mem_magazine_t* mag, size_t size);
+void* gui_mem_magazine_alloc(gui_mem_magazine_t* mag);
+void gui_mem_magazine_free(gui_mem_magazine_t* mag, void* ptr);
+void gui_mem_magazine_flush(gui_mem_magazine_t* mag);
     
 /**
  * \}
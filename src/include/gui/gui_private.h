@@ -73,6 +73,51 @@ typedef struct {
 } GUI_OS_t;
 #endif /* GUI_CFG_OS */
 
+#if GUI_CFG_USE_ADAPTIVE_QUALITY || __DOXYGEN__
+/**
+ * \brief           Adaptive quality management
+ */
+typedef struct {
+    uint32_t degrade;                       /*!< Currently degraded features, \ref GUI_FLAGS_QUALITY */
+    uint32_t paint_time;                    /*!< Paint time of last frame in units of milliseconds */
+    uint32_t last_frame;                    /*!< Time when last frame was drawn or quality was restored */
+    uint32_t idle_time;                     /*!< Current idle time before quality is restored by one step */
+    uint8_t restored;                       /*!< Quality was restored and no frame was drawn since then */
+    gui_quality_policy_fn policy;           /*!< Policy function to decide about degraded features */
+} gui_quality_core_t;
+
+/**
+ * \brief           Check if drawing feature is currently degraded
+ * \param[in]       f: Feature flag, member of \ref GUI_FLAGS_QUALITY
+ * \hideinitializer
+ */
+#define guii_quality_isdegraded(f)  ((GUI.quality.degrade & (f)) == (f))
+#else /* GUI_CFG_USE_ADAPTIVE_QUALITY || __DOXYGEN__ */
+#define guii_quality_isdegraded(f)  0
+#endif /* !(GUI_CFG_USE_ADAPTIVE_QUALITY || __DOXYGEN__) */
+
+#if GUI_CFG_USE_REDRAW_SLICE || __DOXYGEN__
+/**
+ * \brief           Time-sliced redraw management
+ */
+typedef struct {
+    uint32_t start;                         /*!< Start time of current slice */
+    uint32_t paint_time;                    /*!< Paint time of previous slices of current frame */
+    uint8_t expired;                        /*!< Slice time has expired and drawing is suspended */
+    uint8_t in_progress;                    /*!< Frame is partially drawn on drawing layer */
+} gui_redraw_slice_t;
+#endif /* GUI_CFG_USE_REDRAW_SLICE || __DOXYGEN__ */
+
+#if GUI_CFG_USE_WIDGET_TREE || __DOXYGEN__
+/**
+ * \brief           Static memory block for widgets of widget tree
+ */
+typedef struct {
+    uint8_t* mem;                           /*!< Pointer to free memory in block, `NULL` when widget tree is not being created */
+    size_t size;                            /*!< Number of free bytes in block */
+} gui_widget_block_t;
+#endif /* GUI_CFG_USE_WIDGET_TREE || __DOXYGEN__ */
+
 /**
  * \brief           GUI main object structure
  */
@@ -83,13 +128,16 @@ typedef struct {
     uint32_t flags;                         /*!< Core GUI flags management */
     
     gui_display_t display;                  /*!< Clipping management */
-    gui_display_t display_temp;             /*!< Clipping for widgets for drawing and touch, used for drawing area of current widget */
     
     gui_handle_p window_active;             /*!< Pointer to currently active window when creating new widgets */
     gui_handle_p focused_widget;            /*!< Pointer to focused widget for keyboard events if any */
     gui_handle_p focused_widget_prev;       /*!< Pointer to previously focused widget */
     
+#if GUI_CFG_WIDGET_CHILD_ARRAY || __DOXYGEN__
+    gui_widgetarray_t root;                 /*!< Root array of widgets */
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY || __DOXYGEN__ */
     gui_linkedlistroot_t root;              /*!< Root linked list of widgets */
+#endif /* !(GUI_CFG_WIDGET_CHILD_ARRAY || __DOXYGEN__) */
     gui_timer_core_t timers;                /*!< Software structure management */
     
     gui_linkedlistroot_t root_fonts;        /*!< Root linked list of font widgets */
@@ -107,7 +155,19 @@ typedef struct {
 #if GUI_CFG_USE_TRANSLATE
     gui_translate_t translate;              /*!< Translation management structure */
 #endif /* GUI_CFG_USE_TRANSLATE */
-    
+
+#if GUI_CFG_USE_ADAPTIVE_QUALITY || __DOXYGEN__
+    gui_quality_core_t quality;             /*!< Adaptive quality management */
+#endif /* GUI_CFG_USE_ADAPTIVE_QUALITY || __DOXYGEN__ */
+
+#if GUI_CFG_USE_REDRAW_SLICE || __DOXYGEN__
+    gui_redraw_slice_t redraw_slice;        /*!< Time-sliced redraw management */
+#endif /* GUI_CFG_USE_REDRAW_SLICE || __DOXYGEN__ */
+
+#if GUI_CFG_USE_WIDGET_TREE || __DOXYGEN__
+    gui_widget_block_t widget_block;        /*!< Static memory block for widgets while widget tree is created */
+#endif /* GUI_CFG_USE_WIDGET_TREE || __DOXYGEN__ */
+
 #if GUI_CFG_OS
     GUI_OS_t OS;                            /*!< Operating system dependant structure */
 #endif /* GUI_CFG_OS */
@@ -77,6 +77,18 @@ typedef void (*gui_sys_thread_fn)(void *);
  * \}
  */
 
+/**
+ * \brief           Full memory barrier
+ *
+ *                  Memory accesses before barrier are completed before any access after barrier.
+ *                  Used by data shared between threads without GUI core protection.
+ *                  Define it in port header when compiler does not support `__sync_synchronize`
+ * \hideinitializer
+ */
+#ifndef GUI_SYS_BARRIER
+#define GUI_SYS_BARRIER()           __sync_synchronize()
+#endif /* GUI_SYS_BARRIER */
+
 uint8_t     gui_sys_init(void);
 uint32_t    gui_sys_now(void);
 
@@ -57,6 +57,7 @@ typedef int                         gui_sys_thread_prio_t;
 #define GUI_SYS_TIMEOUT             (INFINITE)
 #define GUI_SYS_THREAD_PRIO         (0)
 #define GUI_SYS_THREAD_SS           (1024)
+#define GUI_SYS_BARRIER()           MemoryBarrier()
 
 #endif /* GUI_CFG_OS && !__DOXYGEN__ */
 
@@ -74,8 +74,19 @@ typedef enum {
 typedef enum {
     GUI_GRAPH_TYPE_YT = 0x00,               /*!< Data type is Y versus time */
     GUI_GRAPH_TYPE_XY = 0x01,               /*!< Data type is Y versus X [Y(x)] */
+    GUI_GRAPH_TYPE_BARS = 0x02,             /*!< Data values are drawn as bars, bar at index `i` covers X range from `i` to `i + 1` */
+    GUI_GRAPH_TYPE_SCATTER = 0x03,          /*!< Data type is Y versus X, points are not connected and are colored by number of points on each pixel */
 } gui_graph_type_t;
 
+/**
+ * \brief           Graph data value format enumeration
+ */
+typedef enum {
+    GUI_GRAPH_DATA_FORMAT_INT16 = 0x00,     /*!< Values are stored as `int16_t` */
+    GUI_GRAPH_DATA_FORMAT_INT32 = 0x01,     /*!< Values are stored as `int32_t` */
+    GUI_GRAPH_DATA_FORMAT_FLOAT = 0x02,     /*!< Values are stored as `float` */
+} gui_graph_data_format_t;
+
 struct gui_graph_data;
 
 typedef struct gui_graph_data * gui_graph_data_p; /*!< Graph data pointer */
@@ -93,10 +104,21 @@ uint8_t         gui_graph_attachdata(gui_handle_p h, gui_graph_data_p data);
 uint8_t         gui_graph_detachdata(gui_handle_p h, gui_graph_data_p data);
 
 gui_graph_data_p    gui_graph_data_create(gui_id_t id, gui_graph_type_t type, size_t length);
+gui_graph_data_p    gui_graph_data_createex(gui_id_t id, gui_graph_type_t type, gui_graph_data_format_t format, size_t length);
 uint8_t             gui_graph_data_addvalue(gui_graph_data_p data, int16_t x, int16_t y);
+uint8_t             gui_graph_data_addvalues(gui_graph_data_p data, const void* values, size_t count);
+uint8_t             gui_graph_data_setvalues(gui_graph_data_p data, const void* values, size_t count);
+uint8_t             gui_graph_data_setbuffer(gui_graph_data_p data, void* buff, size_t length, const volatile size_t* ptr);
+uint8_t             gui_graph_data_beginwrite(gui_graph_data_p data);
+uint8_t             gui_graph_data_endwrite(gui_graph_data_p data, size_t count);
 uint8_t             gui_graph_data_setcolor(gui_graph_data_p data, gui_color_t color);
+uint8_t             gui_graph_data_setpeakdecay(gui_graph_data_p data, float decay);
 gui_graph_data_p    gui_graph_data_get_by_id(gui_handle_p graph_h, gui_id_t id);
 
+#if !__DOXYGEN__ && defined(GUI_INTERNAL)
+void                guii_graph_process(void);
+#endif /* !__DOXYGEN__ && defined(GUI_INTERNAL) */
+
  
 /**
  * \}
@@ -210,7 +210,24 @@ extern "C" {
  * \retval          Color value
  * \hideinitializer
  */
-#define guii_widget_getcolor(h, index)              (__GH(h)->colors != NULL ? __GH(h)->colors[(uint8_t)(index)] : (__GH(h)->widget->colors != NULL ? __GH(h)->widget->colors[(uint8_t)(index)] : GUI_COLOR_BLACK))
+#define guii_widget_getcolor(h, index)              (guii_widget_ext(h)->colors != NULL ? guii_widget_ext(h)->colors[(uint8_t)(index)] : (__GH(h)->widget->colors != NULL ? __GH(h)->widget->colors[(uint8_t)(index)] : GUI_COLOR_BLACK))
+
+/**
+ * \brief           Get rarely used values of widget for reading
+ *
+ *                  Use \ref guii_widget_ext_create to get values for writing
+ *
+ * \note            The function is private and can be called only when GUI protection against multiple access is activated
+ * \param[in]       h: Widget handle
+ * \retval          Pointer to constant \ref gui_handle_ext_t structure, never `NULL`.
+ *                  Default values are returned when widget has no own values yet
+ * \hideinitializer
+ */
+#if GUI_CFG_WIDGET_LAZY_EXT || __DOXYGEN__
+#define guii_widget_ext(h)                          ((const gui_handle_ext_t *)(__GH(h)->ext != NULL ? __GH(h)->ext : &guii_widget_ext_default))
+#else /* GUI_CFG_WIDGET_LAZY_EXT || __DOXYGEN__ */
+#define guii_widget_ext(h)                          ((const gui_handle_ext_t *)&__GH(h)->ext)
+#endif /* !(GUI_CFG_WIDGET_LAZY_EXT || __DOXYGEN__) */
 
 /**
  * \brief           Returns width of parent element. If parent does not exists, it returns LCD width
@@ -290,7 +307,11 @@ extern "C" {
  * \return          `1` on success, `0` otherwise
  * \hideinitializer
  */
+#if GUI_CFG_WIDGET_CHILD_ARRAY
+#define guii_widget_haschildren(h)                  (guii_widget_allowchildren(h) && (h)->root_list.count > 0)
+#else /* GUI_CFG_WIDGET_CHILD_ARRAY */
 #define guii_widget_haschildren(h)                  (guii_widget_allowchildren(h) && gui_linkedlist_hasentries(&h->root_list))
+#endif /* !GUI_CFG_WIDGET_CHILD_ARRAY */
 
 /**
  * \brief           Check if widget is base for dialog
@@ -332,6 +353,7 @@ extern "C" {
 uint8_t         guii_widget_processtextkey(gui_handle_p h, guii_keyboard_data_t* key);
 
 uint8_t         guii_widget_setparam(gui_handle_p h, uint16_t cfg, const void* data, uint8_t invalidate, uint8_t invalidateparent);
+uint8_t         guii_widget_invalidaterect(gui_handle_p h, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2);
 uint8_t         guii_widget_getparam(gui_handle_p h, uint16_t cfg, void* data);
 gui_dim_t       guii_widget_getparentabsolutex(gui_handle_p h);
 gui_dim_t       guii_widget_getparentabsolutey(gui_handle_p h);
@@ -553,6 +575,11 @@ void guii_widget_active_set(gui_handle_p h);
 
 //Execute actual widget remove process
 uint8_t guii_widget_executeremove(void);
+uint8_t guii_widget_removenow(gui_handle_p h);
+
+//Rarely used values of widget
+extern gui_handle_ext_t guii_widget_ext_default;
+gui_handle_ext_t* guii_widget_ext_create(gui_handle_p h);
 #endif /* !__DOXYGEN__ */
 
 /**
@@ -0,0 +1,89 @@
+/**	
+ * \file            gui_widget_tree.h
+ * \brief           Static widget trees
+ */
+ 
+/*
+ * Copyright (c) 2017 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+#ifndef GUI_HDR_WIDGET_TREE_H
+#define GUI_HDR_WIDGET_TREE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gui_widget.h"
+
+/**
+ * \ingroup         GUI_WIDGETS
+ * \defgroup        GUI_WIDGET_TREE Static widget trees
+ * \brief           Widget trees described with constant data
+ * \{
+ *
+ * Widget tree is table of constant entries, which can be placed to read-only memory.
+ * All widgets of tree are created with single call and their memory is taken from static memory block,
+ * without allocation for every widget
+ *
+ * \note            Enable \ref GUI_CFG_USE_WIDGET_TREE to use this module
+ */
+
+/**
+ * \brief           Entry has no parent entry in table and uses parent widget passed to \ref gui_widget_tree_create
+ */
+#define GUI_WIDGET_TREE_PARENT_NONE         ((uint16_t)0xFFFF)
+
+/**
+ * \brief           Widget tree entry, describing single widget
+ */
+typedef struct {
+    gui_widget_createfunc_fn create;        /*!< Widget create function, such as \ref gui_button_create */
+    gui_id_t id;                            /*!< Widget ID */
+    float x;                                /*!< Widget `X` position relative to parent widget */
+    float y;                                /*!< Widget `Y` position relative to parent widget */
+    float width;                            /*!< Widget width */
+    float height;                           /*!< Widget height */
+    uint16_t parent;                        /*!< Index of parent entry in table, which must be before this entry,
+                                                    or \ref GUI_WIDGET_TREE_PARENT_NONE */
+    uint16_t flags;                         /*!< Flags for create procedure */
+    const gui_char* text;                   /*!< Widget text or `NULL`. Text is not copied, pointer must stay valid */
+    gui_widget_evt_fn evt_fn;               /*!< Widget callback function or `NULL` for default callback */
+} gui_widget_tree_entry_t;
+
+uint8_t         gui_widget_tree_create(const gui_widget_tree_entry_t* entries, size_t count, gui_handle_p* handles, void* mem, size_t mem_size, gui_handle_p parent);
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GUI_HDR_WIDGET_TREE_H */
@@ -59,6 +59,8 @@ extern "C" {
 #include "widget/gui_radio.h"
 #include "widget/gui_slider.h"
 #include "widget/gui_textview.h"
+#include "widget/gui_waterfall.h"
+#include "widget/gui_widget_tree.h"
 #include "widget/gui_window.h"
 
 /* C++ detection */
@@ -348,8 +348,8 @@ gui_ll_control(gui_lcd_t* LCD, GUI_LL_Command_t cmd, void* param, void* result)
                 static uint8_t SDRAMMemory[SDRAM_HEAP_SIZE] __attribute__((at(SDRAM_START_ADR + SDRAM_MEMORY_SIZE - SDRAM_HEAP_SIZE))); /* SDRAM heap memory */
 #endif
                 static GUI_MEM_Region_t const regions[] = {
-                    {DTCMMemory1, sizeof(DTCMMemory1)},
-                    {SDRAMMemory, sizeof(SDRAMMemory)},
+                    {DTCMMemory1, sizeof(DTCMMemory1), GUI_MEM_CLASS_FAST},
+                    {SDRAMMemory, sizeof(SDRAMMemory), GUI_MEM_CLASS_BULK | GUI_MEM_CLASS_DMA},
                 };
                 gui_mem_assignmemory(regions, GUI_COUNT_OF(regions));
             } while (0);
@@ -105,11 +105,11 @@ gui_widget_t widget = {
 static gui_dim_t
 item_height(gui_handle_p h, uint16_t* offset) {
     gui_dim_t size = 0;
-    if (h->font != NULL) {
-        size = GUI_DIM((float)h->font->size * 1.3f);
+    if (guii_widget_ext(h)->font != NULL) {
+        size = GUI_DIM((float)guii_widget_ext(h)->font->size * 1.3f);
     }
     if (offset != NULL) {                           /* Calculate top offset */
-        *offset = (size - h->font->size) >> 1;
+        *offset = (size - guii_widget_ext(h)->font->size) >> 1;
     }
     return size;                                    /* Return height for element */
 }
@@ -122,7 +122,7 @@ item_height(gui_handle_p h, uint16_t* offset) {
 static int16_t
 nr_entries_pp(gui_handle_p h) {
     int16_t res = 0;
-    if (h->font != NULL) {                          /* Font is responsible for this setup */
+    if (guii_widget_ext(h)->font != NULL) {         /* Font is responsible for this setup */
         res = gui_widget_getheight(h) / item_height(h, NULL);
     }
     return res;
@@ -219,7 +219,7 @@ gui_debugbox_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
             }
             
             /* Draw text if possible */
-            if (h->font != NULL && gui_widget_list_get_count(h, &o->ld)) {
+            if (guii_widget_ext(h)->font != NULL && gui_widget_list_get_count(h, &o->ld)) {
                 gui_draw_text_t f;
                 gui_debugbox_item_t* item;
                 uint16_t itemheight;
@@ -270,7 +270,7 @@ gui_debugbox_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
         }
         case GUI_EVT_TOUCHMOVE: {
             guii_touch_data_t* ts = GUI_EVT_PARAMTYPE_TOUCH(param);  /* Get touch data */
-            if (h->font != NULL) {
+            if (guii_widget_ext(h)->font != NULL) {
                 gui_dim_t height = item_height(h, NULL);   /* Get element height */
                 
                 if (GUI_ABS(ty - ts->y_rel[0]) > height) {
@@ -87,7 +87,7 @@ static dissmissed_dialog_list_t *
 add_to_active_dialogs(gui_handle_p h) {
     dissmissed_dialog_list_t* l;
     
-    l = GUI_MEMALLOC(sizeof(*l));                   /* Allocate memory for dismissed dialog list */
+    l = GUI_POOLALLOC(sizeof(*l));                  /* Allocate memory for dismissed dialog list */
     if (l != NULL) {
         l->h = h;
         l->id = gui_widget_getid(h);
@@ -100,7 +100,7 @@ add_to_active_dialogs(gui_handle_p h) {
 static void
 remove_from_active_dialogs(dissmissed_dialog_list_t* l) {
     gui_linkedlist_remove_gen(&ddlist, &l->list);   /* Remove entry from linked list first */
-    GUI_MEMFREE(l);                                 /* Free memory */
+    GUI_POOLFREE(l, sizeof(*l));                    /* Free memory */
 }
 
 /* Get entry from linked list for specific dialog */
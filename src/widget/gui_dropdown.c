@@ -133,11 +133,11 @@ get_opened_positions(gui_handle_p h, gui_dim_t* y, gui_dim_t* height, gui_dim_t*
 static gui_dim_t
 item_height(gui_handle_p h, uint16_t* offset) {
     gui_dim_t size = 0;
-    if (h->font != NULL) {
-        size = GUI_DIM((float)h->font->size * 1.3f);
+    if (guii_widget_ext(h)->font != NULL) {
+        size = GUI_DIM((float)guii_widget_ext(h)->font->size * 1.3f);
     }
     if (offset != NULL) {                           /* Calculate top offset */
-        *offset = (size - h->font->size) >> 1;
+        *offset = (size - guii_widget_ext(h)->font->size) >> 1;
     }
     return size;                                    /* Return height for element */
 }
@@ -150,7 +150,7 @@ item_height(gui_handle_p h, uint16_t* offset) {
 static int16_t
 nr_entries_pp(gui_handle_p h) {
     int16_t res = 0;
-    if (h->font != NULL) {
+    if (guii_widget_ext(h)->font != NULL) {
         gui_dim_t height = gui_widget_getheight(h);
         if (!is_opened(h)) {
             height *= HEIGHT_CONST(h) - 1;          /* Get height of opened area part */
@@ -255,7 +255,7 @@ delete_item(gui_handle_p h, int16_t index) {
  */
 static uint8_t
 remove_item_memory(gui_handle_p h, void* item) {
-    GUI_MEMFREE(item);
+    GUI_POOLFREE(item, sizeof(gui_dropdown_item_t));
     return 1;
 }
 
@@ -352,7 +352,7 @@ gui_dropdown_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
                 gui_draw_filledrectangle(disp, x + 2, y + 2, width - 4, height - 4, guii_widget_getcolor(h, GUI_DROPDOWN_COLOR_BG));
             }
                 
-            if (o->selected >= 0 && h->font != NULL) {
+            if (o->selected >= 0 && guii_widget_ext(h)->font != NULL) {
                 gui_draw_text_t f;
                 gui_dropdown_item_t* item;
                 gui_draw_text_init(&f);             /* Init structure */
@@ -391,7 +391,7 @@ gui_dropdown_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
                 width--;                            /* Go down for one for alignment on non-slider */
             }
             
-            if (is_opened(h) && h->font != NULL && gui_widget_list_get_count(h, &o->ld)) {
+            if (is_opened(h) && guii_widget_ext(h)->font != NULL && gui_widget_list_get_count(h, &o->ld)) {
                 gui_draw_text_t f;
                 gui_dropdown_item_t* item;
                 uint16_t yOffset, itemheight;
@@ -445,7 +445,7 @@ gui_dropdown_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
         }
         case GUI_EVT_TOUCHMOVE: {
             guii_touch_data_t* ts = GUI_EVT_PARAMTYPE_TOUCH(param);  /* Get touch data */
-            if (h->font != NULL) {
+            if (guii_widget_ext(h)->font != NULL) {
                 gui_dim_t height = item_height(h, NULL);
                 
                 if (GUI_ABS(ty - ts->y_rel[0]) > height) {
@@ -536,7 +536,7 @@ gui_dropdown_addstring(gui_handle_p h, const gui_char* text) {
     
     GUI_ASSERTPARAMS(h != NULL && h->widget == &widget);
 
-    item = GUI_MEMALLOC(sizeof(*item));             /* Allocate memory for entry */
+    item = GUI_POOLALLOC(sizeof(*item));            /* Allocate memory for entry */
     if (item != NULL) {
         item->text = (gui_char *)text;
         gui_widget_list_add_item(h, &o->ld, item);  /* Add to linkedlist */
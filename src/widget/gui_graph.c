@@ -34,6 +34,73 @@
 #include "gui/gui_private.h"
 #include "widget/gui_graph.h"
 
+/**
+ * \ingroup         GUI_GRAPH
+ * \brief           Decimated plot column, all samples mapped to the same screen column
+ */
+typedef struct {
+    gui_dim_t x;                                    /*!< Column X position on screen */
+    gui_dim_t first;                                /*!< Y position of first sample in column */
+    gui_dim_t last;                                 /*!< Y position of last sample in column */
+    gui_dim_t min;                                  /*!< Minimal Y position in column */
+    gui_dim_t max;                                  /*!< Maximal Y position in column */
+} graph_column_t;
+
+/**
+ * \ingroup         GUI_GRAPH
+ * \brief           Mapping of plot values to screen positions
+ */
+typedef struct {
+    float x_left;                                   /*!< X position of plot area left edge */
+    float y_bottom;                                 /*!< Y position of plot area bottom edge */
+    float x_step;                                   /*!< Number of pixels per X unit */
+    float y_step;                                   /*!< Number of pixels per Y unit */
+    float min_x;                                    /*!< Visible minimal X value */
+    float min_y;                                    /*!< Visible minimal Y value */
+    gui_dim_t x_right;                              /*!< X position of plot area right edge */
+    gui_dim_t y_top;                                /*!< Y position of plot area top edge */
+    gui_dim_t x_off;                                /*!< Number of pixels added to X position of every point */
+    gui_dim_t y_off;                                /*!< Number of pixels added to Y position of every point */
+    size_t skip;                                    /*!< Number of samples to advance for each drawn point */
+} graph_view_t;
+
+#if GUI_CFG_WIDGET_GRAPH_DATA_CACHE || __DOXYGEN__
+/**
+ * \ingroup         GUI_GRAPH
+ * \brief           Cache of decimated plot columns
+ */
+typedef struct {
+    graph_column_t* columns;                        /*!< Decimated columns */
+    size_t size;                                    /*!< Number of allocated columns */
+    size_t count;                                   /*!< Number of valid columns */
+    gui_handle_p graph;                             /*!< Graph widget cache was built for */
+    uint32_t version;                               /*!< Data version cache was built for */
+    graph_view_t view;                              /*!< Mapping cache was built for */
+} graph_cache_t;
+#endif /* GUI_CFG_WIDGET_GRAPH_DATA_CACHE || __DOXYGEN__ */
+
+/**
+ * \ingroup         GUI_GRAPH
+ * \brief           Hit-count buffer of scatter plot, one counter for each pixel of plot area
+ */
+typedef struct {
+    uint8_t* hits;                                  /*!< Number of points on each pixel, limited to `255` */
+    size_t size;                                    /*!< Number of allocated counters */
+    gui_handle_p graph;                             /*!< Graph widget buffer was built for */
+    uint32_t version;                               /*!< Data version buffer was built for */
+    graph_view_t view;                              /*!< Mapping buffer was built for */
+} graph_density_t;
+
+/**
+ * \ingroup         GUI_GRAPH
+ * \brief           State of single bar in \ref GUI_GRAPH_TYPE_BARS data object
+ */
+typedef struct {
+    float value;                                    /*!< Bar value to draw */
+    float peak;                                     /*!< Peak-hold value */
+    uint32_t version;                               /*!< Data version when bar or its peak last changed */
+} graph_bar_t;
+
 /**
  * \ingroup         GUI_GRAPH
  * \brief           Graph data widget structure
@@ -45,14 +112,63 @@ typedef struct gui_graph_data {
     
     gui_id_t id;                                    /*!< Data ID */
     
-    int16_t* data;                                  /*!< Pointer to actual data object */
+    void* data;                                     /*!< Pointer to actual data object */
+    gui_graph_data_format_t format;                 /*!< Format of stored values */
     size_t length;                                  /*!< Size of data array */
     size_t ptr;                                     /*!< Read/Write start pointer */
     
+    uint8_t user_buff;                              /*!< Status whether data array is owned by user */
+    const volatile size_t* user_ptr;                /*!< Pointer to user write index (oldest sample) or `NULL` if not used */
+    volatile uint32_t seq;                          /*!< Sequence counter, odd value while user writes to data array */
+    volatile uint32_t written;                      /*!< Number of values written to user array, increased by writer only */
+    uint32_t applied;                               /*!< Value of written counter when graphs were last updated */
+    struct gui_graph_data* next_user;               /*!< Next data object with user array */
+    
     gui_color_t color;                              /*!< Curve color */
     gui_graph_type_t type;                          /*!< Plot data type */
+    
+    uint32_t version;                               /*!< Data version, increased by number of written samples */
+    
+    graph_bar_t* bars;                              /*!< State of bars for \ref GUI_GRAPH_TYPE_BARS type */
+    float peak_decay;                               /*!< Decrease of peak-hold values on every update, `0` when disabled */
+    size_t dirty_first;                             /*!< Index of first bar changed with last update */
+    size_t dirty_end;                               /*!< Index after last bar changed with last update */
+    
+    graph_density_t density;                        /*!< Hit-count buffer for \ref GUI_GRAPH_TYPE_SCATTER type */
+#if GUI_CFG_WIDGET_GRAPH_DATA_CACHE || __DOXYGEN__
+    graph_cache_t cache;                            /*!< Cache of decimated plot */
+#endif /* GUI_CFG_WIDGET_GRAPH_DATA_CACHE || __DOXYGEN__ */
 } gui_graph_data_t;
 
+#if GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT || __DOXYGEN__
+
+#define GRAPH_RETAINED_DATA     4                   /* Maximal number of data objects tracked for scrolling */
+
+/**
+ * \ingroup         GUI_GRAPH
+ * \brief           Retained plot area of graph widget
+ *
+ *                  Plot area is kept in virtual layer, used as ring buffer in both directions.
+ *                  When plot moves, only origin in ring buffer is moved
+ *                  and newly exposed part of plot is drawn
+ */
+typedef struct {
+    gui_layer_t* layer;                             /*!< Virtual layer with plot area pixels */
+    gui_dim_t ox;                                   /*!< Column in layer where plot area left edge is stored */
+    gui_dim_t oy;                                   /*!< Row in layer where plot area top edge is stored */
+    uint8_t valid;                                  /*!< Status whether layer content is valid */
+    
+    graph_view_t view;                              /*!< Mapping layer content was drawn with */
+    gui_color_t fg;                                 /*!< Foreground color layer content was drawn with */
+    gui_color_t grid;                               /*!< Grid color layer content was drawn with */
+    gui_graph_data_p data[GRAPH_RETAINED_DATA];     /*!< Data objects drawn on layer */
+    uint32_t version[GRAPH_RETAINED_DATA];          /*!< Version of each data object drawn on layer */
+    gui_color_t color[GRAPH_RETAINED_DATA];         /*!< Color of each data object drawn on layer */
+    size_t data_count;                              /*!< Number of data objects drawn on layer */
+} graph_retained_t;
+
+#endif /* GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT || __DOXYGEN__ */
+
 /**
  * \ingroup         GUI_GRAPH
  * \brief           Graph widget structure
@@ -72,6 +188,9 @@ typedef struct {
     float visible_max_x;                            /*!< Visible maximal X value for plot */
     float visible_min_y;                            /*!< Visible minimal Y value for plot */
     float visible_max_y;                            /*!< Visible maximal Y value for plot */
+#if GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT || __DOXYGEN__
+    graph_retained_t retained;                      /*!< Retained plot area */
+#endif /* GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT || __DOXYGEN__ */
 } gui_graph_t;
 
 #define CFG_MIN_X           0x01
@@ -80,8 +199,75 @@ typedef struct {
 #define CFG_MAX_Y           0x04
 #define CFG_ZOOM_RESET      0x05
 
+#define GRAPH_LINE_POINTS   32                      /* Number of plot points drawn at once */
+#define GRAPH_DRAW_RETRIES  3                       /* Maximal number of drawings when data change during drawing */
+#define GRAPH_DENSITY_LEVELS    8                   /* Number of colors for scatter plot, one per power of 2 of hits */
+
+/* Check if data points have X and Y value */
+#define GRAPH_HAS_X(data)   ((data)->type == GUI_GRAPH_TYPE_XY || (data)->type == GUI_GRAPH_TYPE_SCATTER)
+
+/**
+ * \brief           Plot points waiting to be drawn as poly line
+ */
+typedef struct {
+    gui_draw_poly_t points[GRAPH_LINE_POINTS];      /*!< List of points */
+    size_t count;                                   /*!< Number of valid points */
+    graph_column_t col;                             /*!< Column currently being decimated */
+    uint8_t col_valid;                              /*!< Status whether column has samples */
+} graph_line_t;
+
 static uint8_t gui_graph_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const param, gui_evt_result_t* const result);
 
+static gui_graph_data_t* user_datas;                /* List of data objects with user array */
+static volatile uint8_t user_pending;               /* Set by writer when any user array was written */
+
+/**
+ * \brief           Get size of single sample in data object
+ * \param[in]       data: Data object handle
+ * \return          Sample size in units of bytes
+ */
+static size_t
+graph_data_itemsize(gui_graph_data_p data) {
+    size_t size;
+    
+    switch (data->format) {
+        case GUI_GRAPH_DATA_FORMAT_INT32: size = sizeof(int32_t); break;
+        case GUI_GRAPH_DATA_FORMAT_FLOAT: size = sizeof(float); break;
+        default: size = sizeof(int16_t); break;
+    }
+    return GRAPH_HAS_X(data) ? 2 * size : size;     /* XY sample has X and Y value */
+}
+
+/**
+ * \brief           Read value from data object
+ * \param[in]       data: Data object handle
+ * \param[in]       index: Value index in data array
+ * \return          Value at index
+ */
+static float
+graph_data_getvalue(gui_graph_data_p data, size_t index) {
+    switch (data->format) {
+        case GUI_GRAPH_DATA_FORMAT_INT32: return (float)((int32_t *)data->data)[index];
+        case GUI_GRAPH_DATA_FORMAT_FLOAT: return ((float *)data->data)[index];
+        default: return (float)((int16_t *)data->data)[index];
+    }
+}
+
+/**
+ * \brief           Write value to data object
+ * \param[in]       data: Data object handle
+ * \param[in]       index: Value index in data array
+ * \param[in]       value: Value to write
+ */
+static void
+graph_data_setvalue(gui_graph_data_p data, size_t index, int16_t value) {
+    switch (data->format) {
+        case GUI_GRAPH_DATA_FORMAT_INT32: ((int32_t *)data->data)[index] = value; break;
+        case GUI_GRAPH_DATA_FORMAT_FLOAT: ((float *)data->data)[index] = (float)value; break;
+        default: ((int16_t *)data->data)[index] = value; break;
+    }
+}
+
 /**
  * \brief           List of default color in the same order of widget color enumeration
  */
@@ -121,25 +307,1004 @@ graph_reset(gui_handle_p h) {
 }
 
 /**
- * \brief           Zoom plot with specific zoom at specific coordinates
- * \param[in]       h: Widget handle
- * \param[in]       zoom: Zoom multiplier. number > 1 is zoom, less is unzoom
- * \param[in]       xpos, ypos: X and Y position for zoom coordinate on screen
+ * \brief           Zoom plot with specific zoom at specific coordinates
+ * \param[in]       h: Widget handle
+ * \param[in]       zoom: Zoom multiplier. number > 1 is zoom, less is unzoom
+ * \param[in]       xpos, ypos: X and Y position for zoom coordinate on screen
+ */
+static void
+graph_zoom(gui_handle_p h, float zoom, float xpos, float ypos) {
+    gui_graph_t* g = (gui_graph_t *)h;
+
+    if (xpos < 0.0f || xpos > 1.0f) { xpos = 0.5f; }
+    if (ypos < 0.0f || ypos > 1.0f) { ypos = 0.5f; }
+           
+    g->visible_min_x += (g->visible_max_x - g->visible_min_x) * (zoom - 1.0f) * xpos;
+    g->visible_max_x -= (g->visible_max_x - g->visible_min_x) * (zoom - 1.0f) * (1.0f - xpos);
+
+    g->visible_min_y += (g->visible_max_y - g->visible_min_y) * (zoom - 1.0f) * ypos;
+    g->visible_max_y -= (g->visible_max_y - g->visible_min_y) * (zoom - 1.0f) * (1.0f - ypos);
+}
+
+/**
+ * \brief           Draw collected plot points
+ * \param[in]       disp: Display region for drawing
+ * \param[in,out]   line: Collected plot points
+ * \param[in]       color: Plot color
+ */
+static void
+graph_line_draw(const gui_display_t* disp, graph_line_t* line, gui_color_t color) {
+    if (line->count > 1) {
+        gui_draw_polyline(disp, line->points, line->count, color);
+        line->points[0] = line->points[line->count - 1];    /* Last point starts next part of plot */
+        line->count = 1;
+    }
+}
+
+/**
+ * \brief           Add point to plot and draw collected points when buffer is full
+ * \param[in]       disp: Display region for drawing
+ * \param[in,out]   line: Collected plot points
+ * \param[in]       x: Point X position on screen
+ * \param[in]       y: Point Y position on screen
+ * \param[in]       color: Plot color
+ */
+static void
+graph_line_push(const gui_display_t* disp, graph_line_t* line, gui_dim_t x, gui_dim_t y, gui_color_t color) {
+    if (line->count > 0 && line->points[line->count - 1].x == x && line->points[line->count - 1].y == y) {
+        return;                                     /* Same as previous point */
+    }
+    line->points[line->count].x = x;
+    line->points[line->count].y = y;
+    if (++line->count == GRAPH_LINE_POINTS) {
+        graph_line_draw(disp, line, color);
+    }
+}
+
+/**
+ * \brief           Start new plot column with first sample
+ * \param[out]      col: Column to start
+ * \param[in]       x: Column X position on screen
+ * \param[in]       y: Sample Y position on screen
+ */
+static void
+graph_column_start(graph_column_t* col, gui_dim_t x, gui_dim_t y) {
+    col->x = x;
+    col->first = col->last = col->min = col->max = y;
+}
+
+/**
+ * \brief           Add sample to plot column
+ * \param[in,out]   col: Column to update
+ * \param[in]       y: Sample Y position on screen
+ */
+static void
+graph_column_update(graph_column_t* col, gui_dim_t y) {
+    col->last = y;
+    col->min = GUI_MIN(col->min, y);
+    col->max = GUI_MAX(col->max, y);
+}
+
+/**
+ * \brief           Add decimated column to plot
+ *
+ *                  First, minimal, maximal and last sample of column are connected,
+ *                  which draws the same pixels as lines between all samples of column
+ *
+ * \param[in]       disp: Display region for drawing
+ * \param[in,out]   line: Collected plot points
+ * \param[in]       col: Column to add
+ * \param[in]       color: Plot color
+ */
+static void
+graph_line_addcolumn(const gui_display_t* disp, graph_line_t* line, const graph_column_t* col, gui_color_t color) {
+    graph_line_push(disp, line, col->x, col->first, color);
+    graph_line_push(disp, line, col->x, col->min, color);
+    graph_line_push(disp, line, col->x, col->max, color);
+    graph_line_push(disp, line, col->x, col->last, color);
+}
+
+/**
+ * \brief           Add sample to plot with min/max decimation
+ *
+ *                  Consecutive samples on the same screen column are merged together,
+ *                  thus number of drawn lines depends on plot width instead of number of samples
+ *
+ * \param[in]       disp: Display region for drawing
+ * \param[in,out]   line: Collected plot points
+ * \param[in]       x: Sample X position on screen
+ * \param[in]       y: Sample Y position on screen
+ * \param[in]       color: Plot color
+ */
+static void
+graph_line_add(const gui_display_t* disp, graph_line_t* line, gui_dim_t x, gui_dim_t y, gui_color_t color) {
+    if (line->col_valid && line->col.x == x) {      /* Sample is on the same column */
+        graph_column_update(&line->col, y);
+    } else {
+        if (line->col_valid) {
+            graph_line_addcolumn(disp, line, &line->col, color);    /* Add finished column */
+        }
+        graph_column_start(&line->col, x, y);
+        line->col_valid = 1;
+    }
+}
+
+/**
+ * \brief           Draw all remaining plot points
+ * \param[in]       disp: Display region for drawing
+ * \param[in,out]   line: Collected plot points
+ * \param[in]       color: Plot color
+ */
+static void
+graph_line_flush(const gui_display_t* disp, graph_line_t* line, gui_color_t color) {
+    if (line->col_valid) {
+        graph_line_addcolumn(disp, line, &line->col, color);
+        line->col_valid = 0;
+    }
+    graph_line_draw(disp, line, color);
+}
+
+#if GUI_CFG_WIDGET_GRAPH_DATA_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Add sample to cache of decimated columns
+ * \param[in,out]   cache: Cache to add sample to
+ * \param[in]       x: Sample X position on screen
+ * \param[in]       y: Sample Y position on screen
+ */
+static void
+graph_cache_add(graph_cache_t* cache, gui_dim_t x, gui_dim_t y) {
+    if (cache->count > 0 && cache->columns[cache->count - 1].x == x) {
+        graph_column_update(&cache->columns[cache->count - 1], y);
+    } else if (cache->count < cache->size) {
+        graph_column_start(&cache->columns[cache->count++], x, y);
+    }
+}
+
+#endif /* GUI_CFG_WIDGET_GRAPH_DATA_CACHE || __DOXYGEN__ */
+
+/**
+ * \brief           Process YT plot samples visible between 2 screen X positions
+ *
+ *                  Samples outside range are skipped, except one on each side
+ *                  to draw lines entering and leaving the range
+ *
+ * \param[in]       disp: Display region for drawing
+ * \param[in]       data: Data object handle
+ * \param[in]       v: Plot mapping to screen
+ * \param[in]       x_from: Left X position of range
+ * \param[in]       x_to: Right X position of range
+ * \param[in,out]   line: Plot to add samples to. Set to `NULL` to add them to cache instead
+ */
+static void
+graph_yt_process(const gui_display_t* disp, gui_graph_data_p data, const graph_view_t* v, gui_dim_t x_from, gui_dim_t x_to, graph_line_t* line) {
+    float x0, x, y;
+    size_t read, next, i, k;
+    
+    x_from -= v->x_off;                             /* Work without pixel offset */
+    x_to -= v->x_off;
+    x0 = v->x_left - v->min_x * v->x_step;          /* X position of oldest sample */
+    if (x0 > x_to || (x0 + (data->length * v->x_step)) < x_from) {
+        return;                                     /* Plot is outside range */
+    }
+    
+    /* Skip samples on the left of range */
+    i = 0;
+    if (x0 < x_from) {
+        i = (size_t)((x_from - x0) / v->x_step);
+        if (i > 0) {
+            i--;                                    /* Keep one sample for line entering range */
+        }
+        if (i >= data->length) {
+            i = data->length - 1;
+        }
+    }
+    read = data->ptr + i;                           /* Oldest sample is on write pointer */
+    if (read >= data->length) {
+        read -= data->length;
+    }
+    
+    while (1) {
+        /*
+         * Position is calculated from sample index only,
+         * thus each sample is always on the same position, no matter where processing started
+         */
+        x = x0 + (float)i * v->x_step;
+        y = v->y_bottom - (graph_data_getvalue(data, read) - v->min_y) * v->y_step;
+#if GUI_CFG_WIDGET_GRAPH_DATA_CACHE
+        if (line == NULL) {
+            graph_cache_add(&data->cache, GUI_DIM(x) + v->x_off, GUI_DIM(y) + v->y_off);
+        } else
+#endif /* GUI_CFG_WIDGET_GRAPH_DATA_CACHE */
+        {
+            graph_line_add(disp, line, GUI_DIM(x) + v->x_off, GUI_DIM(y) + v->y_off, data->color);
+        }
+        if (x > x_to) {                             /* Line leaving range is added */
+            break;
+        }
+        
+        /* Go to next sample, skip samples in degraded quality */
+        for (k = 0; k < v->skip; k++) {
+            next = read + 1 == data->length ? 0 : read + 1;
+            if (next == data->ptr) {                /* Newest sample reached */
+                break;
+            }
+            read = next;
+            i++;
+        }
+        if (k == 0) {                               /* No more samples */
+            break;
+        }
+    }
+}
+
+#if GUI_CFG_WIDGET_GRAPH_DATA_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Get cache of decimated YT plot, rebuild it when data or mapping changed
+ * \param[in]       h: Graph widget handle
+ * \param[in]       data: Data object handle
+ * \param[in]       v: Plot mapping to screen
+ * \return          Pointer to valid cache on success, `NULL` otherwise
+ */
+static graph_cache_t*
+graph_cache_get(gui_handle_p h, gui_graph_data_p data, const graph_view_t* v) {
+    graph_cache_t* cache = &data->cache;
+    size_t size;
+    
+    if (cache->columns != NULL && cache->graph == h && cache->version == data->version
+        && !memcmp(&cache->view, v, sizeof(*v))) {
+        return cache;                               /* Cache is up to date */
+    }
+    
+    /* Every column of plot area plus one on each side */
+    size = (size_t)(v->x_right - GUI_DIM(v->x_left)) + 3;
+    if (cache->size < size) {
+        if (cache->columns != NULL) {
+            GUI_MEMFREE(cache->columns);
+        }
+        cache->size = 0;
+        cache->columns = GUI_MEMALLOC(sizeof(*cache->columns) * size);
+        if (cache->columns == NULL) {
+            return NULL;
+        }
+        cache->size = size;
+    }
+    
+    cache->graph = h;
+    cache->version = data->version;
+    memcpy(&cache->view, v, sizeof(*v));
+    cache->count = 0;
+    graph_yt_process(NULL, data, v, GUI_DIM(v->x_left), v->x_right, NULL); /* Decimate whole plot area */
+    return cache;
+}
+
+#endif /* GUI_CFG_WIDGET_GRAPH_DATA_CACHE || __DOXYGEN__ */
+
+/**
+ * \brief           Get screen columns covered by bar
+ * \param[in]       v: Plot mapping to screen
+ * \param[in]       index: Bar index
+ * \param[out]      x1: Left X position of bar
+ * \param[out]      x2: X position after right edge of bar, including gap to next bar
+ */
+static void
+graph_bar_getx(const graph_view_t* v, size_t index, gui_dim_t* x1, gui_dim_t* x2) {
+    float x0 = v->x_left - v->min_x * v->x_step;    /* X position of first bar */
+    
+    *x1 = GUI_DIM(x0 + (float)index * v->x_step) + v->x_off;
+    *x2 = GUI_DIM(x0 + (float)(index + 1) * v->x_step) + v->x_off;
+}
+
+/**
+ * \brief           Get screen Y position of bar value
+ *
+ *                  Position is limited to plot area, thus value far outside visible range
+ *                  does not overflow screen coordinates
+ *
+ * \param[in]       v: Plot mapping to screen
+ * \param[in]       value: Bar value
+ * \return          Y position on screen
+ */
+static gui_dim_t
+graph_bar_gety(const graph_view_t* v, float value) {
+    float y = v->y_bottom - (value - v->min_y) * v->y_step;
+    
+    /* Offset is added after conversion, the same way as for other plots */
+    if (y < (float)(v->y_top - 1 - v->y_off)) {
+        y = (float)(v->y_top - 1 - v->y_off);
+    } else if (y > v->y_bottom + (float)(1 - v->y_off)) {
+        y = v->y_bottom + (float)(1 - v->y_off);
+    }
+    return GUI_DIM(y) + v->y_off;
+}
+
+/**
+ * \brief           Draw bars visible in display region
+ *
+ *                  Each bar is drawn as filled rectangle from zero to its value
+ *                  and peak-hold marker as line on top of it
+ *
+ * \param[in]       disp: Display region for drawing
+ * \param[in]       data: Data object handle
+ * \param[in]       v: Plot mapping to screen
+ */
+static void
+graph_bars_draw(const gui_display_t* disp, gui_graph_data_p data, const graph_view_t* v) {
+    gui_dim_t x1, x2, y, yb, yp;
+    float x0;
+    size_t i = 0;
+    
+    x0 = v->x_left - v->min_x * v->x_step + (float)v->x_off;    /* X position of first bar */
+    if (x0 < (float)disp->x1) {
+        i = (size_t)(((float)disp->x1 - x0) / v->x_step);   /* Skip bars on the left of region */
+    }
+    yb = graph_bar_gety(v, 0.0f);                   /* Bars start at zero value */
+    for (; i < data->length; i++) {
+        graph_bar_getx(v, i, &x1, &x2);
+        if (x1 >= disp->x2) {
+            break;                                  /* Bars on the right of region */
+        }
+        if (x2 - x1 > 2) {
+            x2--;                                   /* Keep gap between wide bars */
+        }
+        y = graph_bar_gety(v, data->bars[i].value);
+        gui_draw_filledrectangle(disp, x1, GUI_MIN(y, yb), x2 - x1, GUI_ABS(y - yb) + 1, data->color);
+        if (data->peak_decay > 0.0f) {              /* Draw peak-hold marker */
+            yp = graph_bar_gety(v, data->bars[i].peak);
+            gui_draw_hline(disp, x1, yp, x2 - x1, data->color);
+        }
+    }
+}
+
+/**
+ * \brief           Get plot area of graph on screen
+ * \param[in]       v: Plot mapping to screen
+ * \param[out]      area: Plot area, end positions are not included
+ */
+static void
+graph_plot_area(const graph_view_t* v, gui_display_t* area) {
+    area->x1 = GUI_DIM(v->x_left);
+    area->y1 = v->y_top;
+    area->x2 = v->x_right;
+    area->y2 = GUI_DIM(v->y_bottom) + 1;
+}
+
+/**
+ * \brief           Get hit-count buffer of scatter plot, rebuild it when data or mapping changed
+ *
+ *                  All points are counted in single pass, no matter how many of them overlap
+ *
+ * \param[in]       h: Graph widget handle
+ * \param[in]       data: Data object handle of \ref GUI_GRAPH_TYPE_SCATTER type
+ * \param[in]       v: Plot mapping to screen
+ * \return          Pointer to valid buffer on success, `NULL` otherwise
+ */
+static graph_density_t*
+graph_density_get(gui_handle_p h, gui_graph_data_p data, const graph_view_t* v) {
+    graph_density_t* d = &data->density;
+    gui_display_t area;
+    gui_dim_t x, y, width;
+    size_t size, i;
+    float fx, fy;
+    uint8_t* hit;
+    
+    if (d->hits != NULL && d->graph == h && d->version == data->version
+        && !memcmp(&d->view, v, sizeof(*v))) {
+        return d;                                   /* Buffer is up to date */
+    }
+    
+    graph_plot_area(v, &area);
+    width = area.x2 - area.x1;
+    if (width <= 0 || area.y2 <= area.y1) {
+        return NULL;
+    }
+    size = (size_t)width * (size_t)(area.y2 - area.y1);
+    if (d->size < size) {
+        if (d->hits != NULL) {
+            GUI_MEMFREE(d->hits);
+        }
+        d->size = 0;
+        d->hits = GUI_MEMALLOC_CLASS(size, GUI_MEM_CLASS_BULK);
+        if (d->hits == NULL) {
+            return NULL;
+        }
+        d->size = size;
+    }
+    
+    d->graph = h;
+    d->version = data->version;
+    memcpy(&d->view, v, sizeof(*v));
+    memset(d->hits, 0x00, size);
+    for (i = 0; i < data->length; i += v->skip) {  /* Count only every n-th point in degraded quality */
+        fx = v->x_left + (graph_data_getvalue(data, 2 * i + 0) - v->min_x) * v->x_step;
+        fy = v->y_bottom - (graph_data_getvalue(data, 2 * i + 1) - v->min_y) * v->y_step;
+        if (fx < (float)(area.x1 - v->x_off - 1) || fx > (float)(area.x2 - v->x_off)
+            || fy < (float)(area.y1 - v->y_off - 1) || fy > (float)(area.y2 - v->y_off)) {
+            continue;                               /* Point is far outside plot area */
+        }
+        
+        /* Convert the same way as other plots, offset is added after conversion */
+        x = GUI_DIM(fx) + v->x_off;
+        y = GUI_DIM(fy) + v->y_off;
+        if (x >= area.x1 && x < area.x2 && y >= area.y1 && y < area.y2) {
+            hit = &d->hits[(size_t)(y - area.y1) * (size_t)width + (size_t)(x - area.x1)];
+            if (*hit < 0xFF) {
+                (*hit)++;
+            }
+        }
+    }
+    return d;
+}
+
+/**
+ * \brief           Draw scatter plot from hit-count buffer
+ *
+ *                  Each pixel is colored by number of points on it, from dark data color
+ *                  for single point to full data color for many points.
+ *                  Neighbour pixels with the same color are drawn as one line
+ *
+ * \param[in]       disp: Display region for drawing, must be inside plot area
+ * \param[in]       data: Data object handle of \ref GUI_GRAPH_TYPE_SCATTER type
+ * \param[in]       v: Plot mapping to screen
+ * \param[in]       d: Hit-count buffer
+ */
+static void
+graph_density_draw(const gui_display_t* disp, gui_graph_data_p data, const graph_view_t* v, const graph_density_t* d) {
+    gui_color_t ramp[GRAPH_DENSITY_LEVELS];
+    gui_display_t area;
+    const uint8_t* hits;
+    gui_dim_t x, y, run_x;
+    uint8_t level, run_level, cnt;
+    uint32_t i, k, c;
+    
+    /* Prepare color for each level, brightness increases with level */
+    for (i = 0; i < GRAPH_DENSITY_LEVELS; i++) {
+        c = data->color & 0xFF000000;
+        for (k = 0; k < 24; k += 8) {
+            c |= ((((data->color >> k) & 0xFF) * (64 + 191 * i / (GRAPH_DENSITY_LEVELS - 1))) / 255) << k;
+        }
+        ramp[i] = c;
+    }
+    
+    graph_plot_area(v, &area);
+    for (y = disp->y1; y < disp->y2; y++) {
+        hits = &d->hits[(size_t)(y - area.y1) * (size_t)(area.x2 - area.x1)];
+        run_x = disp->x1;
+        run_level = 0;
+        for (x = disp->x1; x <= disp->x2; x++) {
+            level = 0;                              /* Level `0` means no point */
+            if (x < disp->x2 && hits[x - area.x1] > 0) {
+                for (level = 1, cnt = hits[x - area.x1] >> 1; cnt > 0; cnt >>= 1) {
+                    level++;                        /* Level is one more than log2 of hits */
+                }
+            }
+            if (level != run_level) {
+                if (run_level > 0) {                /* Draw finished line of equal colors */
+                    gui_draw_hline(disp, run_x, y, x - run_x, ramp[run_level - 1]);
+                }
+                run_x = x;
+                run_level = level;
+            }
+        }
+    }
+}
+
+/**
+ * \brief           Prepare attached data objects for drawing
+ *
+ *                  Write index of user data arrays is read and sum of sequence counters is calculated.
+ *                  When sum is different after drawing, data were modified during drawing
+ *
+ * \param[in]       h: Graph widget handle
+ * \param[out]      writing: Set to `1` when any data array is being written by user
+ * \return          Sum of sequence counters of all attached data objects
+ */
+static uint32_t
+graph_data_sync(gui_handle_p h, uint8_t* writing) {
+    gui_graph_t* g = (gui_graph_t *)h;
+    gui_graph_data_p data;
+    gui_linkedlistmulti_t* link;
+    uint32_t seq, sum = 0;
+    
+    *writing = 0;
+    GUI_SYS_BARRIER();                              /* Values of previous drawing must be read before counters */
+    for (link = gui_linkedlist_multi_getnext_gen(&g->root, NULL); link != NULL; 
+            link = gui_linkedlist_multi_getnext_gen(NULL, link)) {
+        data = (gui_graph_data_p)gui_linkedlist_multi_getdata(link);
+        seq = data->seq;
+        if (seq & 0x01) {                           /* Odd value means write in progress */
+            *writing = 1;
+        }
+        sum += seq;
+        if (data->user_ptr != NULL && data->length > 0) {
+            data->ptr = *data->user_ptr % data->length; /* Oldest sample is on user write index */
+        }
+    }
+    GUI_SYS_BARRIER();                              /* Counters must be read before values of next drawing */
+    return sum;
+}
+
+/**
+ * \brief           Calculate mapping of plot values to screen
+ * \param[in]       h: Graph widget handle
+ * \param[out]      v: Plot mapping to screen
+ */
+static void
+graph_get_view(gui_handle_p h, graph_view_t* v) {
+    gui_graph_t* g = (gui_graph_t *)h;
+    gui_dim_t x, y, width, height;
+    
+    x = gui_widget_getabsolutex(h);
+    y = gui_widget_getabsolutey(h);
+    width = gui_widget_getwidth(h);
+    height = gui_widget_getheight(h);
+    
+    memset(v, 0x00, sizeof(*v));                    /* Reset also padding, view is compared as cache key */
+    v->x_left = (float)(x + g->border[GUI_GRAPH_BORDER_LEFT]);
+    v->x_right = x + width - g->border[GUI_GRAPH_BORDER_RIGHT];
+    v->y_top = y + g->border[GUI_GRAPH_BORDER_TOP];
+    v->y_bottom = (float)(y + height - g->border[GUI_GRAPH_BORDER_BOTTOM] - 1);
+    v->x_step = (float)(width - g->border[GUI_GRAPH_BORDER_LEFT] - g->border[GUI_GRAPH_BORDER_RIGHT]) / (g->visible_max_x - g->visible_min_x);
+    v->y_step = (float)(height - g->border[GUI_GRAPH_BORDER_TOP] - g->border[GUI_GRAPH_BORDER_BOTTOM]) / (g->visible_max_y - g->visible_min_y);
+    v->min_x = g->visible_min_x;
+    v->min_y = g->visible_min_y;
+    
+    /* Draw only every second point when quality is degraded */
+    v->skip = guii_quality_isdegraded(GUI_QUALITY_DEGRADE_GRAPH) ? 2 : 1;
+}
+
+/**
+ * \brief           Draw plot area with grid and all attached plots
+ * \param[in]       h: Graph widget handle
+ * \param[in]       disp: Display region for drawing
+ * \param[in]       v: Plot mapping to screen
+ */
+static void
+graph_draw_plot(gui_handle_p h, const gui_display_t* disp, const graph_view_t* v) {
+    gui_graph_t* g = (gui_graph_t *)h;
+    gui_graph_data_p data;
+    gui_linkedlistmulti_t* link;
+    gui_display_t area, display;
+    graph_line_t line;
+    size_t read, write, next, k;
+    float x1, y1, step;
+    uint8_t i;
+    
+    graph_plot_area(v, &area);
+    
+    /* Set clipping region */
+    display.x1 = GUI_MAX(disp->x1, area.x1);
+    display.y1 = GUI_MAX(disp->y1, area.y1);
+    display.x2 = GUI_MIN(disp->x2, area.x2);
+    display.y2 = GUI_MIN(disp->y2, area.y2);
+    if (display.x1 >= display.x2 || display.y1 >= display.y2) {
+        return;                                     /* Plot area is not visible */
+    }
+    
+    gui_draw_filledrectangle(&display, area.x1, area.y1, area.x2 - area.x1, area.y2 - area.y1, guii_widget_getcolor(h, GUI_GRAPH_COLOR_FG));
+    
+    /* Draw horizontal lines */
+    if (g->rows) {
+        step = (float)(area.y2 - area.y1) / (float)g->rows;
+        for (i = 1; i < g->rows; i++) {
+            gui_draw_hline(&display, area.x1, GUI_DIM(area.y1 + i * step), area.x2 - area.x1, guii_widget_getcolor(h, GUI_GRAPH_COLOR_GRID));
+        }
+    }
+    /* Draw vertical lines */
+    if (g->columns) {
+        step = (float)(area.x2 - area.x1) / (float)g->columns;
+        for (i = 1; i < g->columns; i++) {
+            gui_draw_vline(&display, GUI_DIM(area.x1 + i * step), area.y1, area.y2 - area.y1, guii_widget_getcolor(h, GUI_GRAPH_COLOR_GRID));
+        }
+    }
+    
+    /* Draw all plot attached to graph */
+    for (link = gui_linkedlist_multi_getnext_gen(&g->root, NULL); link != NULL; 
+            link = gui_linkedlist_multi_getnext_gen(NULL, link)) {
+        data = (gui_graph_data_p)gui_linkedlist_multi_getdata(link);/* Get data from list */
+        if (data->data == NULL || data->length == 0) {
+            continue;                               /* No data array attached */
+        }
+        
+        line.count = 0;
+        line.col_valid = 0;
+        if (data->type == GUI_GRAPH_TYPE_YT) {      /* Draw YT plot */
+#if GUI_CFG_WIDGET_GRAPH_DATA_CACHE
+            graph_cache_t* cache = NULL;
+            if (display.x1 == area.x1 && display.x2 == area.x2) {  /* Use cache when whole plot width is drawn */
+                cache = graph_cache_get(h, data, v);
+            }
+            if (cache != NULL) {                    /* Draw decimated columns from cache */
+                for (k = 0; k < cache->count; k++) {
+                    graph_line_addcolumn(&display, &line, &cache->columns[k], data->color);
+                }
+            } else
+#endif /* GUI_CFG_WIDGET_GRAPH_DATA_CACHE */
+            {
+                graph_yt_process(&display, data, v, display.x1, display.x2, &line);
+            }
+        } else if (data->type == GUI_GRAPH_TYPE_SCATTER) {  /* Draw scatter plot */
+            graph_density_t* density = graph_density_get(h, data, v);
+            if (density != NULL) {
+                graph_density_draw(&display, data, v, density);
+            }
+        } else if (data->type == GUI_GRAPH_TYPE_BARS) { /* Draw bars */
+            if (data->bars != NULL) {
+                graph_bars_draw(&display, data, v);
+            }
+        } else if (data->type == GUI_GRAPH_TYPE_XY) {   /* Draw XY plot */
+            read = data->ptr;                       /* Get start read pointer */
+            write = data->ptr;                      /* Get start write pointer */
+            do {
+                x1 = v->x_left + (graph_data_getvalue(data, 2 * read + 0) - v->min_x) * v->x_step;
+                y1 = v->y_bottom - (graph_data_getvalue(data, 2 * read + 1) - v->min_y) * v->y_step;
+                graph_line_add(&display, &line, GUI_DIM(x1) + v->x_off, GUI_DIM(y1) + v->y_off, data->color);
+                
+                /* Go to next point, skip points in degraded quality */
+                for (k = 0; k < v->skip; k++) {
+                    next = read + 1 == data->length ? 0 : read + 1;
+                    if (next == write) {
+                        break;
+                    }
+                    read = next;
+                }
+            } while (k > 0);
+        }
+        graph_line_flush(&display, &line, data->color); /* Draw remaining points */
+    }
+}
+
+#if GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT || __DOXYGEN__
+
+/**
+ * \brief           Split screen area to parts stored continuously in retained layer
+ *
+ *                  Because layer is ring buffer, area may wrap around layer edges
+ *                  and up to `4` parts are required to cover it
+ *
+ * \param[in]       r: Retained plot
+ * \param[in]       plot: Plot area on screen
+ * \param[in]       area: Area to split, must be inside plot area
+ * \param[out]      parts: Parts of area on screen
+ * \param[out]      pos: Layer position on screen for each part, stored as `x1` and `y1`
+ * \return          Number of parts
+ */
+static size_t
+graph_retained_split(const graph_retained_t* r, const gui_display_t* plot, const gui_display_t* area, gui_display_t* parts, gui_display_t* pos) {
+    gui_dim_t xsplit, ysplit, xi, yi;
+    size_t cnt = 0;
+    
+    xsplit = plot->x1 + r->layer->width - r->ox;    /* First column stored at the beginning of layer */
+    ysplit = plot->y1 + r->layer->height - r->oy;   /* First row stored at the beginning of layer */
+    for (yi = 0; yi < 2; yi++) {
+        for (xi = 0; xi < 2; xi++) {
+            parts[cnt].x1 = xi ? GUI_MAX(area->x1, xsplit) : area->x1;
+            parts[cnt].x2 = xi ? area->x2 : GUI_MIN(area->x2, xsplit);
+            parts[cnt].y1 = yi ? GUI_MAX(area->y1, ysplit) : area->y1;
+            parts[cnt].y2 = yi ? area->y2 : GUI_MIN(area->y2, ysplit);
+            if (parts[cnt].x1 < parts[cnt].x2 && parts[cnt].y1 < parts[cnt].y2) {
+                pos[cnt].x1 = plot->x1 - r->ox + (xi ? r->layer->width : 0);
+                pos[cnt].y1 = plot->y1 - r->oy + (yi ? r->layer->height : 0);
+                cnt++;
+            }
+        }
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Draw part of plot area to retained layer
+ * \param[in]       h: Graph widget handle
+ * \param[in]       v: Plot mapping to screen
+ * \param[in]       x1, y1, x2, y2: Area on screen to draw, end positions are not included
+ */
+static void
+graph_retained_draw(gui_handle_p h, const graph_view_t* v, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2) {
+    graph_retained_t* r = &((gui_graph_t *)h)->retained;
+    gui_display_t plot, area, parts[4], pos[4];
+    gui_layer_t* layer_prev;
+    size_t i, cnt;
+    
+    graph_plot_area(v, &plot);
+    area.x1 = GUI_MAX(x1, plot.x1);
+    area.y1 = GUI_MAX(y1, plot.y1);
+    area.x2 = GUI_MIN(x2, plot.x2);
+    area.y2 = GUI_MIN(y2, plot.y2);
+    
+    layer_prev = GUI.lcd.drawing_layer;             /* Draw to retained layer */
+    GUI.lcd.drawing_layer = r->layer;
+    cnt = graph_retained_split(r, &plot, &area, parts, pos);
+    for (i = 0; i < cnt; i++) {
+        r->layer->x_pos = pos[i].x1;
+        r->layer->y_pos = pos[i].y1;
+        graph_draw_plot(h, &parts[i], v);
+    }
+    GUI.lcd.drawing_layer = layer_prev;             /* Restore drawing layer */
+}
+
+/**
+ * \brief           Draw bars changed since retained layer was drawn
+ *
+ *                  Consecutive changed bars are drawn together,
+ *                  other bars are kept in retained layer as they are
+ *
+ * \param[in]       h: Graph widget handle
+ * \param[in]       v: Plot mapping to screen
+ * \param[in]       data: Data object handle of \ref GUI_GRAPH_TYPE_BARS type
+ * \param[in]       version: Data version retained layer was drawn with
+ */
+static void
+graph_retained_bars(gui_handle_p h, const graph_view_t* v, gui_graph_data_p data, uint32_t version) {
+    gui_display_t plot;
+    gui_dim_t x1, x2, tmp;
+    size_t i, first;
+    
+    graph_plot_area(v, &plot);
+    for (i = 0; i < data->length; i++) {
+        if ((int32_t)(data->bars[i].version - version) <= 0) {
+            continue;                               /* Bar did not change */
+        }
+        for (first = i; i + 1 < data->length && (int32_t)(data->bars[i + 1].version - version) > 0; i++) {}
+        graph_bar_getx(v, first, &x1, &tmp);
+        graph_bar_getx(v, i, &tmp, &x2);
+        graph_retained_draw(h, v, x1, plot.y1, x2, plot.y2);
+    }
+}
+
+/**
+ * \brief           Move retained plot and draw only changed parts
+ *
+ *                  Plot can be moved when only visible range changed by whole number of pixels
+ *                  or when new samples were added to YT plots.
+ *                  Changed bars of \ref GUI_GRAPH_TYPE_BARS data are drawn again on their positions.
+ *
+ *                  Retained plot keeps mapping of last full drawing and visible range change
+ *                  is applied as pixel offset, thus moved pixels and newly drawn parts always match
+ *
+ * \param[in]       h: Graph widget handle
+ * \param[in]       v: New plot mapping to screen
+ * \param[out]      nv: Mapping used to draw new parts of plot
+ * \return          `1` on success, `0` when whole plot must be drawn
+ */
+static uint8_t
+graph_retained_scroll(gui_handle_p h, const graph_view_t* v, graph_view_t* nv) {
+    gui_graph_t* g = (gui_graph_t *)h;
+    graph_retained_t* r = &g->retained;
+    gui_graph_data_p data;
+    gui_linkedlistmulti_t* link;
+    gui_display_t plot;
+    gui_dim_t dx, dy, xo, yo, pos;
+    uint32_t n, shift = 0;
+    float fxo, fyo, fdx, x0, step;
+    size_t i = 0;
+    uint8_t first = 1, bars = 0;
+    
+    /* Only position may change, mapping must be the same */
+    if (!r->valid || v->skip != 1 || r->view.x_left != v->x_left || r->view.x_right != v->x_right
+        || r->view.y_top != v->y_top || r->view.y_bottom != v->y_bottom
+        || r->view.x_step != v->x_step || r->view.y_step != v->y_step
+        || r->fg != guii_widget_getcolor(h, GUI_GRAPH_COLOR_FG) || r->grid != guii_widget_getcolor(h, GUI_GRAPH_COLOR_GRID)) {
+        return 0;
+    }
+    
+    /*
+     * Check changes of data. New samples move YT plots,
+     * thus all plots must be YT with the same number of new samples.
+     * Bars do not move with new samples and are checked separately
+     */
+    for (link = gui_linkedlist_multi_getnext_gen(&g->root, NULL); link != NULL; 
+            link = gui_linkedlist_multi_getnext_gen(NULL, link), i++) {
+        data = (gui_graph_data_p)gui_linkedlist_multi_getdata(link);
+        if (i >= r->data_count || r->data[i] != data || r->color[i] != data->color) {
+            return 0;
+        }
+        if (data->type == GUI_GRAPH_TYPE_BARS) {
+            bars = 1;
+            continue;
+        }
+        n = data->version - r->version[i];
+        if (first) {
+            shift = n;
+            first = 0;
+        }
+        if (n != shift || (n > 0 && (data->type != GUI_GRAPH_TYPE_YT || n >= data->length))) {
+            return 0;
+        }
+    }
+    if (i != r->data_count || (bars && shift > 0)) {    /* Bars would move together with YT plots */
+        return 0;
+    }
+    
+    /* Calculate pixel offset of visible range against retained mapping */
+    fxo = (r->view.min_x - v->min_x) * v->x_step;
+    fyo = (v->min_y - r->view.min_y) * v->y_step;
+    fdx = (float)shift * v->x_step;                 /* Movement of YT plots */
+    xo = GUI_DIM(fxo >= 0 ? fxo + 0.5f : fxo - 0.5f);
+    yo = GUI_DIM(fyo >= 0 ? fyo + 0.5f : fyo - 0.5f);
+    dx = GUI_DIM(fdx + 0.5f);
+    if (GUI_ABS(fxo - xo) > 0.01f || GUI_ABS(fyo - yo) > 0.01f
+        || fdx != (float)dx) {                      /* YT samples must move exactly, otherwise their positions are not the same */
+        return 0;                                   /* Plot did not move by whole pixels */
+    }
+    dx = xo - r->view.x_off - dx;                   /* Movement of plot on screen */
+    dy = yo - r->view.y_off;
+    if (GUI_ABS(dx) >= r->layer->width || GUI_ABS(dy) >= r->layer->height) {
+        return 0;                                   /* Everything moved out */
+    }
+    memcpy(nv, &r->view, sizeof(*nv));             /* Keep retained mapping with new offset */
+    nv->x_off = xo;
+    nv->y_off = yo;
+    v = nv;
+    
+    /* Move plot origin in ring buffer */
+    r->ox -= dx;
+    if (r->ox < 0) {
+        r->ox += r->layer->width;
+    } else if (r->ox >= r->layer->width) {
+        r->ox -= r->layer->width;
+    }
+    r->oy -= dy;
+    if (r->oy < 0) {
+        r->oy += r->layer->height;
+    } else if (r->oy >= r->layer->height) {
+        r->oy -= r->layer->height;
+    }
+    
+    graph_plot_area(v, &plot);
+    
+    /* Draw newly exposed columns and rows */
+    if (dx > 0) {
+        graph_retained_draw(h, v, plot.x1, plot.y1, plot.x1 + dx, plot.y2);
+    } else if (dx < 0) {
+        graph_retained_draw(h, v, plot.x2 + dx, plot.y1, plot.x2, plot.y2);
+    }
+    if (dy > 0) {
+        graph_retained_draw(h, v, plot.x1, plot.y1, plot.x2, plot.y1 + dy);
+    } else if (dy < 0) {
+        graph_retained_draw(h, v, plot.x1, plot.y2 + dy, plot.x2, plot.y2);
+    }
+    
+    /* Grid stays on the same position, draw it again where it was moved from and to */
+    if (dx != 0 && g->columns) {
+        step = (float)(plot.x2 - plot.x1) / (float)g->columns;
+        for (i = 1; i < g->columns; i++) {
+            pos = GUI_DIM(plot.x1 + i * step);
+            graph_retained_draw(h, v, pos, plot.y1, pos + 1, plot.y2);
+            graph_retained_draw(h, v, pos + dx, plot.y1, pos + dx + 1, plot.y2);
+        }
+    }
+    if (dy != 0 && g->rows) {
+        step = (float)(plot.y2 - plot.y1) / (float)g->rows;
+        for (i = 1; i < g->rows; i++) {
+            pos = GUI_DIM(plot.y1 + i * step);
+            graph_retained_draw(h, v, plot.x1, pos, plot.x2, pos + 1);
+            graph_retained_draw(h, v, plot.x1, pos + dy, plot.x2, pos + dy + 1);
+        }
+    }
+    
+    /* Draw columns where YT plots changed with new samples */
+    if (shift > 0) {
+        x0 = v->x_left - v->min_x * v->x_step;      /* Position of oldest sample */
+        
+        /* Lines to removed oldest samples */
+        graph_retained_draw(h, v, GUI_DIM(x0 - (float)shift * v->x_step) + v->x_off, plot.y1, GUI_DIM(x0) + v->x_off + 1, plot.y2);
+        
+        /* Lines to new samples */
+        for (link = gui_linkedlist_multi_getnext_gen(&g->root, NULL); link != NULL; 
+                link = gui_linkedlist_multi_getnext_gen(NULL, link)) {
+            data = (gui_graph_data_p)gui_linkedlist_multi_getdata(link);
+            if (data->type == GUI_GRAPH_TYPE_YT) {
+                graph_retained_draw(h, v, GUI_DIM(x0 + (float)(data->length - 1 - shift) * v->x_step) + v->x_off, plot.y1,
+                    GUI_DIM(x0 + (float)(data->length - 1) * v->x_step) + v->x_off + 1, plot.y2);
+            }
+        }
+    }
+    
+    /* Draw changed bars */
+    if (bars) {
+        i = 0;
+        for (link = gui_linkedlist_multi_getnext_gen(&g->root, NULL); link != NULL; 
+                link = gui_linkedlist_multi_getnext_gen(NULL, link), i++) {
+            data = (gui_graph_data_p)gui_linkedlist_multi_getdata(link);
+            if (data->type == GUI_GRAPH_TYPE_BARS && data->bars != NULL) {
+                graph_retained_bars(h, v, data, r->version[i]);
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Draw plot area from retained layer
+ *
+ *                  Retained layer is updated first, then it is copied to drawing layer
+ *
+ * \param[in]       h: Graph widget handle
+ * \param[in]       disp: Display region for drawing
+ * \param[in]       v: Plot mapping to screen
+ * \return          `1` on success, `0` when plot must be drawn directly
  */
-static void
-graph_zoom(gui_handle_p h, float zoom, float xpos, float ypos) {
+static uint8_t
+graph_retained_blit(gui_handle_p h, const gui_display_t* disp, const graph_view_t* v) {
     gui_graph_t* g = (gui_graph_t *)h;
-
-    if (xpos < 0.0f || xpos > 1.0f) { xpos = 0.5f; }
-    if (ypos < 0.0f || ypos > 1.0f) { ypos = 0.5f; }
-           
-    g->visible_min_x += (g->visible_max_x - g->visible_min_x) * (zoom - 1.0f) * xpos;
-    g->visible_max_x -= (g->visible_max_x - g->visible_min_x) * (zoom - 1.0f) * (1.0f - xpos);
-
-    g->visible_min_y += (g->visible_max_y - g->visible_min_y) * (zoom - 1.0f) * ypos;
-    g->visible_max_y -= (g->visible_max_y - g->visible_min_y) * (zoom - 1.0f) * (1.0f - ypos);
+    graph_retained_t* r = &g->retained;
+    gui_graph_data_p data;
+    gui_linkedlistmulti_t* link;
+    gui_display_t plot, area, parts[4], pos[4];
+    graph_view_t nv;
+    gui_layer_t* dl = GUI.lcd.drawing_layer;
+    gui_dim_t width, height;
+    size_t i, cnt;
+    
+    graph_plot_area(v, &plot);
+    width = plot.x2 - plot.x1;
+    height = plot.y2 - plot.y1;
+    if (GUI.ll.Copy == NULL || width <= 0 || height <= 0) {
+        return 0;
+    }
+    
+    /* Allocate retained layer for current plot size */
+    if (r->layer == NULL || r->layer->width != width || r->layer->height != height) {
+        if (r->layer != NULL) {
+            GUI_MEMFREE(r->layer);
+        }
+        r->valid = 0;
+        r->layer = GUI_MEMALLOC_CLASS(sizeof(*r->layer) + (size_t)width * (size_t)height * (size_t)GUI.lcd.pixel_size,
+            GUI_MEM_CLASS_BULK | GUI_MEM_CLASS_DMA);    /* Layer is copied to display with accelerator */
+        if (r->layer == NULL) {
+            return 0;
+        }
+        r->layer->width = width;
+        r->layer->height = height;
+        r->layer->start_address = ((uint8_t *)r->layer) + sizeof(*r->layer);
+    }
+    
+    /* Update retained layer */
+    if (!graph_retained_scroll(h, v, &nv)) {
+        r->ox = 0;                                  /* Draw whole plot area */
+        r->oy = 0;
+        graph_retained_draw(h, v, plot.x1, plot.y1, plot.x2, plot.y2);
+        memcpy(&nv, v, sizeof(nv));
+    }
+    
+    /* Save state of retained layer */
+    memcpy(&r->view, &nv, sizeof(r->view));
+    r->fg = guii_widget_getcolor(h, GUI_GRAPH_COLOR_FG);
+    r->grid = guii_widget_getcolor(h, GUI_GRAPH_COLOR_GRID);
+    r->data_count = 0;
+    for (link = gui_linkedlist_multi_getnext_gen(&g->root, NULL); link != NULL; 
+            link = gui_linkedlist_multi_getnext_gen(NULL, link), r->data_count++) {
+        data = (gui_graph_data_p)gui_linkedlist_multi_getdata(link);
+        if (r->data_count < GRAPH_RETAINED_DATA) {
+            r->data[r->data_count] = data;
+            r->version[r->data_count] = data->version;
+            r->color[r->data_count] = data->color;
+        }
+    }
+    r->valid = r->data_count <= GRAPH_RETAINED_DATA;    /* Too many data objects to track changes */
+    
+    /* Copy visible part of plot to drawing layer */
+    area.x1 = GUI_MAX(disp->x1, plot.x1);
+    area.y1 = GUI_MAX(disp->y1, plot.y1);
+    area.x2 = GUI_MIN(disp->x2, plot.x2);
+    area.y2 = GUI_MIN(disp->y2, plot.y2);
+    cnt = graph_retained_split(r, &plot, &area, parts, pos);
+    for (i = 0; i < cnt; i++) {
+        GUI.ll.Copy(&GUI.lcd, dl,
+            (void *)(((uint8_t *)dl->start_address) + GUI.lcd.pixel_size * ((parts[i].y1 - dl->y_pos) * dl->width + (parts[i].x1 - dl->x_pos))), /* Destination address */
+            (void *)(((uint8_t *)r->layer->start_address) + GUI.lcd.pixel_size * ((parts[i].y1 - pos[i].y1) * width + (parts[i].x1 - pos[i].x1))), /* Source address */
+            parts[i].x2 - parts[i].x1,              /* Area width */
+            parts[i].y2 - parts[i].y1,              /* Area height */
+            dl->width - (parts[i].x2 - parts[i].x1),    /* Offline destination */
+            width - (parts[i].x2 - parts[i].x1)     /* Offline source */
+        );
+    }
+    return 1;
 }
 
+#endif /* GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT || __DOXYGEN__ */
+
 /**
  * \brief           Default widget callback function
  * \param[in]       h: Widget handle
@@ -183,10 +1348,10 @@ gui_graph_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
             return 1;
         }
         case GUI_EVT_DRAW: {                         /* Draw widget */
-            gui_graph_data_p data;
-            gui_linkedlistmulti_t* link;
             gui_dim_t bt, br, bb, bl, x, y, width, height;
-            uint8_t i;
+            graph_view_t view;
+            uint32_t seq;
+            uint8_t i, writing;
             gui_display_t* disp = GUI_EVT_PARAMTYPE_DISP(param);   /* Get display pointer */
             
             bt = g->border[GUI_GRAPH_BORDER_TOP];
@@ -203,109 +1368,30 @@ gui_graph_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
             gui_draw_filledrectangle(disp, x + bl, y, width - bl - br, bt, guii_widget_getcolor(h, GUI_GRAPH_COLOR_BG));
             gui_draw_filledrectangle(disp, x + bl, y + height - bb, width - bl - br, bb, guii_widget_getcolor(h, GUI_GRAPH_COLOR_BG));
             gui_draw_filledrectangle(disp, x + width - br, y, br, height, guii_widget_getcolor(h, GUI_GRAPH_COLOR_BG));
-            gui_draw_filledrectangle(disp, x + bl, y + bt, width - bl - br, height - bt - bb, guii_widget_getcolor(h, GUI_GRAPH_COLOR_FG));
-            gui_draw_rectangle(disp, x, y, width, height, guii_widget_getcolor(h, GUI_GRAPH_COLOR_BORDER));
             
-            /* Draw horizontal lines */
-            if (g->rows) {
-                float step;
-                step = (float)(height - bt - bb) / (float)g->rows;
-                for (i = 1; i < g->rows; i++) {
-                    gui_draw_hline(disp, GUI_DIM(x + bl), GUI_DIM(y + bt + i * step), GUI_DIM(width - bl - br), guii_widget_getcolor(h, GUI_GRAPH_COLOR_GRID));
-                }
-            }
-            /* Draw vertical lines */
-            if (g->columns) {
-                float step;
-                step = (float)(width - bl - br) / (float)g->columns;
-                for (i = 1; i < g->columns; i++) {
-                    gui_draw_vline(disp, GUI_DIM(x + bl + i * step), GUI_DIM(y + bt), GUI_DIM(height - bt - bb), guii_widget_getcolor(h, GUI_GRAPH_COLOR_GRID));
-                }
-            }
+            graph_get_view(h, &view);               /* Calculate mapping of plot values to screen */
             
-            /* Check if any data attached to this graph */
-            if (gui_linkedlist_hasentries(&g->root)) {  /* We have attached plots */
-                gui_display_t display;
-                register float x1, y1, x2, y2;      /* Try to add these variables to core registers */
-                float xSize = g->visible_max_x - g->visible_min_x;  /* Calculate X size */
-                float ySize = g->visible_max_y - g->visible_min_y;  /* Calculate Y size */
-                float xStep = (float)(width - bl - br) / (float)xSize;  /* Calculate X step */
-                float yStep = (float)(height - bt - bb) / (float)ySize; /* calculate Y step */
-                gui_dim_t yBottom = y + height - bb - 1;    /* Bottom Y value */
-                gui_dim_t xLeft = x + bl;                   /* Left X position */
-                size_t read, write;
-                
-                memcpy(&display, disp, sizeof(gui_display_t));  /* Save GUI display data */
-                
-                /* Set clipping region */
-                if ((x + bl) > disp->x1) {
-                    disp->x1 = x + bl;
-                }
-                if ((x + width - br) < disp->x2) {
-                    disp->x2 = x + width - br;
-                }
-                if ((y + bt) > disp->y1) {
-                    disp->y1 = y + bt;
+            /*
+             * User data arrays are read in place without waiting for writer.
+             * Draw again when data were modified during drawing,
+             * graph is invalidated after write anyway
+             */
+            for (i = 0; i < GRAPH_DRAW_RETRIES; i++) {
+                seq = graph_data_sync(h, &writing);
+#if GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT
+                if (!graph_retained_blit(h, disp, &view))   /* Copy plot from retained layer */
+#endif /* GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT */
+                {
+                    graph_draw_plot(h, disp, &view);    /* Draw plot directly */
                 }
-                if ((y + height - bb) < disp->y2) {
-                    disp->y2 = y + height - bb;
+                if (!writing && seq == graph_data_sync(h, &writing)) {
+                    break;                          /* Data were consistent during drawing */
                 }
-                
-                /* Draw all plot attached to graph */
-                for (link = gui_linkedlist_multi_getnext_gen(&g->root, NULL); link != NULL; 
-                        link = gui_linkedlist_multi_getnext_gen(NULL, link)) {
-                    data = (gui_graph_data_p)gui_linkedlist_multi_getdata(link);/* Get data from list */
-                    
-                    read = data->ptr;               /* Get start read pointer */
-                    write = data->ptr;              /* Get start write pointer */
-                    
-                    if (data->type == GUI_GRAPH_TYPE_YT) {  /* Draw YT plot */
-                        /* Calculate first point */
-                        x1 = xLeft - g->visible_min_x * xStep;  /* Calculate start X */
-                        y1 = yBottom - (data->data[read] - g->visible_min_y) * yStep;   /* Calculate start Y */
-                        if (++read == data->length) {   /* Check overflow */
-                            read = 0;
-                        }
-                        
-                        /* Outside of right || outside on left */
-                        if (x1 > disp->x2 || (x1 + (data->length * xStep)) < disp->x1) {/* Plot start is on the right of active area */
-                            continue;
-                        }
-                        
-                        while (read != write && x1 <= disp->x2) {   /* Calculate next points */
-                            x2 = x1 + xStep;                /* Calculate next X */
-                            y2 = yBottom - ((float)data->data[read] - g->visible_min_y) * yStep;/* Calculate next Y */
-                            if ((x1 >= disp->x1 || x2 >= disp->x1) && (x1 < disp->x2 || x2 < disp->x2)) {
-                                gui_draw_line(disp, GUI_DIM(x1), GUI_DIM(y1), GUI_DIM(x2), GUI_DIM(y2), data->color);   /* Draw actual line */
-                            }
-                            x1 = x2, y1 = y2;       /* Copy values as old */
-                            
-                            if (++read == data->length) {   /* Check overflow */
-                                read = 0;
-                            }
-                        }
-                    } else if (data->type == GUI_GRAPH_TYPE_XY) {   /* Draw XY plot */                        
-                        /* Calculate first point */
-                        x1 = xLeft + ((float)data->data[2 * read + 0] - g->visible_min_x) * xStep;
-                        y1 = yBottom - ((float)data->data[2 * read + 1] - g->visible_min_y) * yStep;
-                        if (++read == data->length) {   /* Check overflow */
-                            read = 0;
-                        }
-                        
-                        while (read != write) {     /* Calculate next points */
-                            x2 = xLeft + ((float)(data->data[2 * read + 0] - g->visible_min_x) * xStep);
-                            y2 = yBottom - ((float)(data->data[2 * read + 1] - g->visible_min_y) * yStep);
-                            gui_draw_line(disp, GUI_DIM(x1), GUI_DIM(y1), GUI_DIM(x2), GUI_DIM(y2), data->color);   /* Draw actual line */
-                            x1 = x2, y1 = y2;       /* Check overflow */
-                            
-                            if (++read == data->length) {   /* Check overflow */
-                                read = 0;
-                            }
-                        }
-                    }
-                }
-                memcpy(disp, &display, sizeof(gui_display_t));  /* Copy data back */
+#if GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT
+                g->retained.valid = 0;              /* Retained plot may contain partially written data */
+#endif /* GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT */
             }
+            gui_draw_rectangle(disp, x, y, width, height, guii_widget_getcolor(h, GUI_GRAPH_COLOR_BORDER));
             return 1;
         }
 #if GUI_CFG_USE_TOUCH
@@ -350,8 +1436,9 @@ gui_graph_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
             gui_widget_invalidate(h);               /* Invalidate widget */
             return 1;
         
-#if GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE
+#if GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE || GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT
         case GUI_EVT_REMOVE: {                       /* When widget is about to be removed */
+#if GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE
             gui_graph_data_p data;
             gui_linkedlistmulti_t* link;
             
@@ -361,10 +1448,16 @@ gui_graph_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
                 data = (gui_graph_data_p)gui_linkedlist_multi_getdata(link);    /* Get data from list */
                 gui_linkedlist_multi_find_remove(&data->root, h);   /* Remove element from linked list with search */
             }
+#endif /* GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE */
+#if GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT
+            if (g->retained.layer != NULL) {
+                GUI_MEMFREE(g->retained.layer);     /* Free retained plot area */
+            }
+#endif /* GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT */
             
             return 1;
         }
-#endif /* GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE */
+#endif /* GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE || GUI_CFG_WIDGET_GRAPH_SCROLL_BLIT */
         default:                                    /* Handle default option */
             GUI_UNUSED3(h, param, result);          /* Unused elements to prevent compiler warnings */
             return 0;                               /* Command was not processed */
@@ -391,7 +1484,129 @@ graph_invalidate(gui_graph_data_p data) {
         gui_widget_invalidate(h);   
     }
 }
+
+/**
+ * \brief           Invalidate part of graph where bars changed with last update
+ * \param[in]       h: Graph widget handle
+ * \param[in]       data: Data object handle of \ref GUI_GRAPH_TYPE_BARS type
+ */
+static void
+graph_bars_invalidate(gui_handle_p h, gui_graph_data_p data) {
+    graph_view_t view;
+    gui_dim_t x1, x2, tmp;
+    
+    if (data->dirty_first >= data->dirty_end) {
+        return;                                     /* No bar changed */
+    }
+    graph_get_view(h, &view);
+    graph_bar_getx(&view, data->dirty_first, &x1, &tmp);
+    graph_bar_getx(&view, data->dirty_end - 1, &tmp, &x2);
+    x1 = GUI_MAX(x1, GUI_DIM(view.x_left));
+    x2 = GUI_MIN(x2, view.x_right);
+    if (x1 < x2) {                                  /* Redraw only visible changed bars */
+        guii_widget_invalidaterect(h, x1 - 1, view.y_top, x2 + 1, GUI_DIM(view.y_bottom) + 1);
+    }
+}
+#endif /* GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE */
+
+/**
+ * \brief           Update bars of data object after values changed
+ *
+ *                  Peak-hold values decay towards bar values
+ *                  and every changed bar is marked with current data version
+ *
+ * \param[in]       data: Data object handle of \ref GUI_GRAPH_TYPE_BARS type
+ */
+static void
+graph_bars_update(gui_graph_data_p data) {
+    graph_bar_t* bar;
+    float value, peak;
+    size_t i, read;
+    
+    data->dirty_first = data->length;
+    data->dirty_end = 0;
+    if (data->bars == NULL || data->data == NULL) {
+        return;
+    }
+    read = data->ptr;
+    if (data->user_ptr != NULL) {
+        read = *data->user_ptr % data->length;      /* Oldest value is on user write index */
+    }
+    for (i = 0; i < data->length; i++, read = read + 1 == data->length ? 0 : read + 1) {
+        bar = &data->bars[i];
+        value = graph_data_getvalue(data, read);
+        peak = value;
+        if (data->peak_decay > 0.0f) {              /* Decay peak, but never below value */
+            peak = GUI_MAX(bar->peak - data->peak_decay, value);
+        }
+        if (value != bar->value || peak != bar->peak) {
+            bar->value = value;
+            bar->peak = peak;
+            bar->version = data->version;
+            data->dirty_first = GUI_MIN(data->dirty_first, i);
+            data->dirty_end = i + 1;
+        }
+    }
+}
+
+/**
+ * \brief           Process change of data object values
+ * \param[in]       data: Data object handle
+ */
+static void
+graph_data_changed(gui_graph_data_p data) {
+#if GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE
+    gui_linkedlistmulti_t* link;
+#endif /* GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE */
+
+    if (data->type != GUI_GRAPH_TYPE_BARS) {
+#if GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE
+        graph_invalidate(data);                     /* Invalidate graphs attached to this data object */
+#endif /* GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE */
+        return;
+    }
+    
+    graph_bars_update(data);
+#if GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE
+    /* Invalidate only changed bars on graphs attached to this data object */
+    for (link = gui_linkedlist_multi_getnext_gen(&data->root, NULL); link != NULL;
+            link = gui_linkedlist_multi_getnext_gen(NULL, link)) {
+        graph_bars_invalidate((gui_handle_p)gui_linkedlist_multi_getdata(link), data);
+    }
 #endif /* GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE */
+}
+
+/**
+ * \brief           Update graphs after user wrote to attached data arrays
+ *
+ *                  \ref gui_graph_data_endwrite only increases counter of written values.
+ *                  Data version, state of bars and invalidation of graphs are updated here
+ *
+ * \note            Called from \ref gui_process with GUI core protection
+ */
+void
+guii_graph_process(void) {
+    gui_graph_data_t* data;
+    uint32_t written;
+    
+    if (!user_pending) {                            /* Nothing was written since last call */
+        return;
+    }
+    user_pending = 0;                               /* Clear before counters are read, writer sets it again */
+    GUI_SYS_BARRIER();
+    for (data = user_datas; data != NULL; data = data->next_user) {
+        written = data->written;
+        if (written != data->applied) {
+            data->version += written - data->applied;   /* Data changed by number of written values */
+            data->applied = written;
+            /*
+             * Bars may read values while user writes new ones,
+             * bars are updated again after next write anyway
+             */
+            graph_data_changed(data);               /* Update graphs attached to this data object */
+        }
+    }
+}
 
 /**
  * \brief           Create new graph widget
@@ -581,22 +1796,43 @@ gui_graph_detachdata(gui_handle_p h, gui_graph_data_p data) {
  * \param[in]       type: Type of data. According to selected type different allocation size will occur
  * \param[in]       length: Number of points on plot.
  * \return          Graph data handle on success, `NULL` otherwise
+ * \sa              gui_graph_data_createex
  */
 gui_graph_data_p
 gui_graph_data_create(gui_id_t id, gui_graph_type_t type, size_t length) {
+    return gui_graph_data_createex(id, type, GUI_GRAPH_DATA_FORMAT_INT16, length);
+}
+
+/**
+ * \brief           Creates data object with specific format of stored values
+ * \note            When \arg GUI_GRAPH_TYPE_XY or \arg GUI_GRAPH_TYPE_SCATTER is used, X and Y values are stored one after another for each point
+ * \param[in]       id: Graph data ID
+ * \param[in]       type: Type of data. According to selected type different allocation size will occur
+ * \param[in]       format: Format of stored values. This parameter can be a value of \ref gui_graph_data_format_t enumeration
+ * \param[in]       length: Number of points on plot.
+ *                      Set to `0` when user data array is attached later with \ref gui_graph_data_setbuffer
+ * \return          Graph data handle on success, `NULL` otherwise
+ */
+gui_graph_data_p
+gui_graph_data_createex(gui_id_t id, gui_graph_type_t type, gui_graph_data_format_t format, size_t length) {
     gui_graph_data_t* data;
 
     data = GUI_MEMALLOC(sizeof(*data));             /* Allocate memory for basic widget */
     if (data != NULL) {
         data->id = id;
         data->type = type;
+        data->format = format;
         data->length = length;
-        if (type == GUI_GRAPH_TYPE_YT) {            /* Only Y values are stored */
-            data->data = GUI_MEMALLOC(sizeof(*data->data) * length);    /* Store Y values for plot */
-        } else {
-            data->data = GUI_MEMALLOC(sizeof(*data->data) * length * 2);/* Store X and Y values for plot */
+        if (length > 0) {
+            data->data = GUI_MEMALLOC_CLASS(graph_data_itemsize(data) * length, GUI_MEM_CLASS_BULK);    /* Store values for plot */
+            if (type == GUI_GRAPH_TYPE_BARS) {
+                data->bars = GUI_MEMALLOC(sizeof(*data->bars) * length);    /* Store state of bars */
+            }
         }
-        if (data->data == NULL) {
+        if (length > 0 && (data->data == NULL || (type == GUI_GRAPH_TYPE_BARS && data->bars == NULL))) {
+            if (data->data != NULL) {
+                GUI_MEMFREE(data->data);
+            }
             GUI_MEMFREE(data);                      /* Remove widget because data memory could not be allocated */
             data = NULL;
         }
@@ -607,28 +1843,219 @@ gui_graph_data_create(gui_id_t id, gui_graph_type_t type, size_t length) {
 
 /**
  * \brief           Add new value to the end of data object
+ * \note            Function fails when user array is attached with \ref gui_graph_data_setbuffer,
+ *                  user writes values directly to its array instead
  * \param[in]       data: Data object handle
- * \param[in]       x: X position for point. Used only in case data type is \ref GUI_GRAPH_TYPE_XY, otherwise it is ignored
+ * \param[in]       x: X position for point. Used only in case data type is \ref GUI_GRAPH_TYPE_XY or \ref GUI_GRAPH_TYPE_SCATTER, otherwise it is ignored
  * \param[in]       y: Y position for point. Always used no matter of data type
  * \return          `1` on success, `0` otherwise
  */
 uint8_t
 gui_graph_data_addvalue(gui_graph_data_p data, int16_t x, int16_t y) {
-    GUI_ASSERTPARAMS(data);                
+    GUI_ASSERTPARAMS(data != NULL && data->data != NULL && !data->user_buff);
 
-    if (data->type == GUI_GRAPH_TYPE_YT) {          /* YT plot */
-        data->data[data->ptr] = y;                  /* Only Y value is relevant */
-    } else if (data->type == GUI_GRAPH_TYPE_XY) {   /* XY plot */
-        data->data[2 * data->ptr + 0] = x;          /* Set X value */
-        data->data[2 * data->ptr + 1] = y;          /* Set Y value */
+    if (GRAPH_HAS_X(data)) {                        /* XY plot */
+        graph_data_setvalue(data, 2 * data->ptr + 0, x);    /* Set X value */
+        graph_data_setvalue(data, 2 * data->ptr + 1, y);    /* Set Y value */
+    } else {                                        /* YT plot or bars */
+        graph_data_setvalue(data, data->ptr, y);    /* Only Y value is relevant */
     }
     data->ptr++;                                    /* Increase write and read pointers */
     if (data->ptr >= data->length) {
         data->ptr = 0;                              /* Reset read operation */
     }
-#if GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE
-    graph_invalidate(data);                         /* Invalidate graphs attached to this data object */
-#endif /* GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE */
+    data->version++;                                /* Data changed */
+    graph_data_changed(data);                       /* Update graphs attached to this data object */
+
+    return 1;
+}
+
+/**
+ * \brief           Add multiple values to the end of data object
+ *
+ *                  Values are copied to data object at once and attached graphs are invalidated only once.
+ *                  When more values than data length are added, only newest values are kept
+ *
+ * \note            Function fails when user array is attached with \ref gui_graph_data_setbuffer,
+ *                  user writes values directly to its array instead
+ * \param[in]       data: Data object handle
+ * \param[in]       values: Array of values in the same format as data object was created with.
+ *                      For \ref GUI_GRAPH_TYPE_XY and \ref GUI_GRAPH_TYPE_SCATTER types, X and Y value are one after another for each point
+ * \param[in]       count: Number of points in array
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_graph_data_addvalues(gui_graph_data_p data, const void* values, size_t count) {
+    const uint8_t* src = values;
+    size_t item_size, len;
+    
+    GUI_ASSERTPARAMS(data != NULL && data->data != NULL && !data->user_buff && values != NULL);
+    
+    if (count == 0) {
+        return 1;
+    }
+    item_size = graph_data_itemsize(data);
+    data->version += (uint32_t)count;               /* Data changed */
+    
+    if (count >= data->length) {                    /* Only newest values fit to data object */
+        src += (count - data->length) * item_size;
+        count = data->length;
+        data->ptr = 0;
+    }
+    
+    /* Copy to the end of array first and wrap to the beginning */
+    len = GUI_MIN(count, data->length - data->ptr);
+    memcpy(((uint8_t *)data->data) + data->ptr * item_size, src, len * item_size);
+    if (len < count) {
+        memcpy(data->data, src + len * item_size, (count - len) * item_size);
+    }
+    data->ptr += count;                             /* Increase write and read pointers */
+    if (data->ptr >= data->length) {
+        data->ptr -= data->length;
+    }
+    graph_data_changed(data);                       /* Update graphs attached to this data object */
+
+    return 1;
+}
+
+/**
+ * \brief           Set all values of data object
+ *
+ *                  Data object content is replaced, first value in array is the oldest on plot.
+ *                  When array has less values than data length, remaining values are set to zero
+ *
+ * \note            Function fails when user array is attached with \ref gui_graph_data_setbuffer,
+ *                  user writes values directly to its array instead
+ * \param[in]       data: Data object handle
+ * \param[in]       values: Array of values in the same format as data object was created with.
+ *                      For \ref GUI_GRAPH_TYPE_XY and \ref GUI_GRAPH_TYPE_SCATTER types, X and Y value are one after another for each point
+ * \param[in]       count: Number of points in array
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_graph_data_setvalues(gui_graph_data_p data, const void* values, size_t count) {
+    size_t item_size;
+    
+    GUI_ASSERTPARAMS(data != NULL && data->data != NULL && !data->user_buff && values != NULL);
+    
+    item_size = graph_data_itemsize(data);
+    count = GUI_MIN(count, data->length);
+    memcpy(data->data, values, count * item_size);
+    memset(((uint8_t *)data->data) + count * item_size, 0x00, (data->length - count) * item_size);
+    data->ptr = 0;                                  /* Oldest value is at the beginning */
+    data->version += (uint32_t)data->length;        /* All values changed */
+    graph_data_changed(data);                       /* Update graphs attached to this data object */
+
+    return 1;
+}
+
+/**
+ * \brief           Attach user data array to data object
+ *
+ *                  Values are read directly from user array when graph is drawn, no copy is made.
+ *                  Array must stay valid while data object is used.
+ *                  User must call \ref gui_graph_data_beginwrite and \ref gui_graph_data_endwrite
+ *                  around every modification of array.
+ *                  Array may be written from any thread without GUI core protection
+ *
+ * \note            Values in array must be in the same format as data object was created with.
+ *                  For \ref GUI_GRAPH_TYPE_XY and \ref GUI_GRAPH_TYPE_SCATTER types, X and Y value are one after another for each point
+ *
+ * \param[in]       data: Data object handle
+ * \param[in]       buff: Pointer to user data array
+ * \param[in]       length: Number of points in array
+ * \param[in]       ptr: Pointer to user write index, index of oldest point in array, when array is used as ring buffer.
+ *                      Set to `NULL` when oldest point is always at the beginning of array
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_graph_data_setbuffer(gui_graph_data_p data, void* buff, size_t length, const volatile size_t* ptr) {
+    size_t i;
+    
+    GUI_ASSERTPARAMS(data != NULL && buff != NULL && length > 0);
+    
+    if (data->type == GUI_GRAPH_TYPE_BARS && (data->bars == NULL || data->length != length)) {
+        if (data->bars != NULL) {
+            GUI_MEMFREE(data->bars);
+        }
+        data->bars = GUI_MEMALLOC(sizeof(*data->bars) * length);    /* Store state of bars */
+        if (data->bars == NULL) {
+            return 0;
+        }
+    }
+    if (!data->user_buff && data->data != NULL) {
+        GUI_MEMFREE(data->data);                    /* Free memory of internal array */
+    }
+    if (!data->user_buff) {
+        data->next_user = user_datas;               /* Add to list of data objects checked after writes */
+        user_datas = data;
+    }
+    data->data = buff;
+    data->length = length;
+    data->user_buff = 1;
+    data->user_ptr = ptr;
+    data->applied = data->written;                  /* Previous writes are not relevant for new array */
+    data->ptr = 0;
+    data->version += (uint32_t)length;              /* All values changed */
+    if (data->bars != NULL) {
+        for (i = 0; i < length; i++) {
+            data->bars[i].version = data->version;  /* Bars are on new positions */
+        }
+    }
+    graph_data_changed(data);                       /* Update graphs attached to this data object */
+
+    return 1;
+}
+
+/**
+ * \brief           Notify data object that user starts modifying its data array
+ *
+ *                  Function never waits for graph to finish drawing.
+ *                  When array is modified while graph is being drawn, graph is drawn again
+ *
+ * \note            This function and \ref gui_graph_data_endwrite are the only functions
+ *                  which may be called without GUI core protection (\ref gui_protect).
+ *                  Only one thread may write to the same array
+ *
+ * \param[in]       data: Data object handle
+ * \return          `1` on success, `0` otherwise
+ * \sa              gui_graph_data_endwrite
+ */
+uint8_t
+gui_graph_data_beginwrite(gui_graph_data_p data) {
+    GUI_ASSERTPARAMS(data != NULL);
+    
+    data->seq++;                                    /* Odd value, write in progress */
+    GUI_SYS_BARRIER();                              /* Counter must change before values */
+    return 1;
+}
+
+/**
+ * \brief           Notify data object that user finished modifying its data array
+ *
+ *                  Function only marks values as written and wakes up GUI thread.
+ *                  Graphs are updated and invalidated later by \ref gui_process
+ *
+ * \note            This function may be called without GUI core protection (\ref gui_protect)
+ *
+ * \param[in]       data: Data object handle
+ * \param[in]       count: Number of new points added to the end of ring buffer.
+ *                      Set to `0` when points were modified in any other way
+ * \return          `1` on success, `0` otherwise
+ * \sa              gui_graph_data_beginwrite
+ */
+uint8_t
+gui_graph_data_endwrite(gui_graph_data_p data, size_t count) {
+    GUI_ASSERTPARAMS(data != NULL);
+    
+    GUI_SYS_BARRIER();                              /* Values must be written before counter changes */
+    data->seq++;                                    /* Even value, write finished */
+    data->written += (uint32_t)(count > 0 ? count : data->length);  /* Data changed */
+    GUI_SYS_BARRIER();                              /* Counters must change before GUI thread is notified */
+    user_pending = 1;
+#if GUI_CFG_OS
+    gui_sys_mbox_putnow(&GUI.OS.mbox, NULL);        /* Wakeup GUI thread */
+#endif /* GUI_CFG_OS */
 
     return 1;
 }
@@ -653,6 +2080,39 @@ gui_graph_data_setcolor(gui_graph_data_p data, gui_color_t color) {
     return 1;
 }
 
+/**
+ * \brief           Set decay of peak-hold markers for \ref GUI_GRAPH_TYPE_BARS data
+ *
+ *                  Peak-hold value of each bar follows bar value when it rises
+ *                  and is decreased by decay value on every data update until it reaches bar value again
+ *
+ * \param[in,out]   data: Graph data handle
+ * \param[in]       decay: Decrease of peak-hold value on every update in units of plot values.
+ *                      Set to `0` to disable peak-hold markers
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_graph_data_setpeakdecay(gui_graph_data_p data, float decay) {
+    size_t i;
+    
+    GUI_ASSERTPARAMS(data != NULL && decay >= 0.0f);
+
+    if (data->peak_decay != decay) {                /* Check decay change */
+        data->peak_decay = decay;
+        data->version++;                            /* Markers changed on all bars */
+        if (data->bars != NULL) {
+            for (i = 0; i < data->length; i++) {
+                data->bars[i].version = data->version;
+            }
+        }
+#if GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE
+        graph_invalidate(data);                     /* Invalidate graphs attached to this data object */
+#endif /* GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE */
+    }
+
+    return 1;
+}
+
 /**
  * \brief           Get data collection with specific ID from graph
  * \param[in]       graph_h: Graph widget handle
@@ -109,11 +109,11 @@ gui_widget_t widget = {
 static gui_dim_t
 item_height(gui_handle_p h, uint16_t* offset) {
     gui_dim_t size = 0;
-    if (h->font != NULL) {
-        size = GUI_DIM((float)h->font->size * 1.3f);
+    if (guii_widget_ext(h)->font != NULL) {
+        size = GUI_DIM((float)guii_widget_ext(h)->font->size * 1.3f);
     }
     if (offset != NULL) {                           /* Calculate top offset */
-        *offset = (size - h->font->size) >> 1;
+        *offset = (size - guii_widget_ext(h)->font->size) >> 1;
     }
     return size;                                    /* Return height for element */
 }
@@ -126,7 +126,7 @@ item_height(gui_handle_p h, uint16_t* offset) {
 static int16_t
 nr_entries_pp(gui_handle_p h) {
     int16_t res = 0;
-    if (h->font != NULL) {                          /* Font is responsible for this setup */
+    if (guii_widget_ext(h)->font != NULL) {         /* Font is responsible for this setup */
         res = gui_widget_getheight(h) / item_height(h, NULL);
     }
     return res;
@@ -181,7 +181,7 @@ delete_item(gui_handle_p h, int16_t index) {
  */
 static uint8_t
 remove_item_memory(gui_handle_p h, void* item) {
-    GUI_MEMFREE(item);
+    GUI_POOLFREE(item, sizeof(gui_listbox_item_t));
     return 1;
 }
 
@@ -246,7 +246,7 @@ gui_listbox_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* cons
             }
             
             /* Draw text if possible */
-            if (h->font != NULL && gui_widget_list_get_count(h, &o->ld)) {  /* Is first set? */
+            if (guii_widget_ext(h)->font != NULL && gui_widget_list_get_count(h, &o->ld)) { /* Is first set? */
                 gui_draw_text_t f;
                 gui_listbox_item_t* item;
                 uint16_t itemheight;
@@ -301,7 +301,7 @@ gui_listbox_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* cons
         }
         case GUI_EVT_TOUCHMOVE: {
             guii_touch_data_t* ts = GUI_EVT_PARAMTYPE_TOUCH(param);  /* Get touch data */
-            if (h->font != NULL) {
+            if (guii_widget_ext(h)->font != NULL) {
                 gui_dim_t height = item_height(h, NULL);   /* Get element height */
                 
                 if (GUI_ABS(ty - ts->y_rel[0]) > height) {
@@ -328,7 +328,7 @@ gui_listbox_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* cons
                     handled = 1;
                 }
             }
-            if (!handled && h->font != NULL) {
+            if (!handled && guii_widget_ext(h)->font != NULL) {
                 uint16_t height = item_height(h, NULL);    /* Get element height */
                 uint16_t tmpselected;
                 
@@ -404,7 +404,7 @@ gui_listbox_addstring(gui_handle_p h, const gui_char* text) {
     
     GUI_ASSERTPARAMS(h != NULL && h->widget == &widget);
 
-    item = GUI_MEMALLOC(sizeof(*item));             /* Allocate memory for entry */
+    item = GUI_POOLALLOC(sizeof(*item));            /* Allocate memory for entry */
     if (item != NULL) {
         item->text = (gui_char *)text;              /* Add text to entry */
         gui_widget_list_add_item(h, &o->ld, item);  /* Add item to linked list */
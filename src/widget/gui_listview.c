@@ -152,11 +152,11 @@ get_item_for_row(gui_handle_p h, gui_listview_row_t* row, uint16_t c) {
 static gui_dim_t
 item_height(gui_handle_p h, uint16_t* offset) {
     gui_dim_t size = 0;
-    if (h->font != NULL) {
-        size = GUI_DIM((float)h->font->size * 1.3f);
+    if (guii_widget_ext(h)->font != NULL) {
+        size = GUI_DIM((float)guii_widget_ext(h)->font->size * 1.3f);
     }
     if (offset != NULL) {                           /* Calculate top offset */
-        *offset = (size - h->font->size) >> 1;
+        *offset = (size - guii_widget_ext(h)->font->size) >> 1;
     }
     return size;                                    /* Return height for element */
 }
@@ -169,7 +169,7 @@ item_height(gui_handle_p h, uint16_t* offset) {
 static int16_t
 nr_entries_pp(gui_handle_p h) {
     int16_t res = 0;
-    if (h->font != NULL) {                          /* Font is responsible for this setup */
+    if (guii_widget_ext(h)->font != NULL) {         /* Font is responsible for this setup */
         gui_dim_t height = item_height(h, 0);       /* Get item height */
         res = (gui_widget_getheight(h) - height) / height;
     }
@@ -209,9 +209,9 @@ remove_row(gui_handle_p h, void* item) {
     
     /* Remove row items (columns) first */
     while ((col = (gui_listview_item_t *)gui_linkedlist_remove_gen(&row->root, (gui_linkedlist_t *)gui_linkedlist_getnext_gen(&row->root, NULL))) != NULL) {
-        GUI_MEMFREE(col);
+        GUI_POOLFREE(col, sizeof(*col));
     }
-    GUI_MEMFREE(item);                              /* Remove item itself */
+    GUI_POOLFREE(item, sizeof(*row));               /* Remove item itself */
     return 1;
 }
 
@@ -310,7 +310,7 @@ gui_listview_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
                 f.y += itemheight;                  /* Go to next line */
                 
                 /* Draw all rows and entry elements */           
-                if (h->font != NULL && gui_widget_list_get_count(h, &o->ld)) {/* Is first set? */
+                if (guii_widget_ext(h)->font != NULL && gui_widget_list_get_count(h, &o->ld)) {/* Is first set? */
                     int16_t index;
                     gui_dim_t tmp;
                     
@@ -357,7 +357,7 @@ gui_listview_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
             if (o->cols != NULL) {
                 uint16_t i = 0;
                 for (i = 0; i < o->col_count; i++) {
-                    GUI_MEMFREE(o->cols[i]);
+                    GUI_POOLFREE(o->cols[i], sizeof(*o->cols[i]));
                 }
                 GUI_MEMFREE(o->cols);
             }
@@ -549,7 +549,7 @@ gui_listview_addcolumn(gui_handle_p h, const gui_char* text, gui_dim_t width) {
     cols = GUI_MEMREALLOC(o->cols, sizeof(*o->cols) * (o->col_count + 2));    /* Allocate new memory block for new pointers of columns */
     if (cols != NULL) {
         o->cols = cols;                       /* Save new pointer of memory */
-        col = GUI_MEMALLOC(sizeof(*col));       /* Allocate memory for new column structure */
+        col = GUI_POOLALLOC(sizeof(*col));      /* Allocate memory for new column structure */
         if (col != NULL) {
             o->cols[o->col_count++] = col;  /* Add column to array list */
             o->cols[o->col_count] = NULL;   /* Add zero to the end of array */
@@ -598,7 +598,7 @@ gui_listview_addrow(gui_handle_p h) {
     
     GUI_ASSERTPARAMS(h != NULL && h->widget == &widget);
 
-    row = GUI_MEMALLOC(sizeof(*row));               /* Allocate memory for new row(s) */
+    row = GUI_POOLALLOC(sizeof(*row));              /* Allocate memory for new row(s) */
     if (row != NULL) {
         gui_widget_list_add_item(h, &o->ld, row);
     }
@@ -653,7 +653,7 @@ gui_listview_setitemstring(gui_handle_p h, gui_listview_row_p row, uint16_t col,
     col++;
     while (col--) {                                 /* Find right column */
         if (item == NULL) {
-            item = GUI_MEMALLOC(sizeof(*item));     /* Allocate for item */
+            item = GUI_POOLALLOC(sizeof(*item));    /* Allocate for item */
             if (item == NULL) {
                 break;
             }
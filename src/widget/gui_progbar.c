@@ -106,8 +106,8 @@ set_value(gui_handle_p h, int32_t val) {
         } else if (o->currentvalue > o->max) {
             o->currentvalue = o->max;
         }
-        if (is_anim(h) && h->timer != NULL) {       /* In case of animation and timer availability */
-            guii_timer_start(h->timer);             /* Start timer */
+        if (is_anim(h) && guii_widget_ext(h)->timer != NULL) { /* In case of animation and timer availability */
+            guii_timer_start(guii_widget_ext(h)->timer); /* Start timer */
         } else {
             o->currentvalue = o->desiredvalue;      /* Set values to the same */
         }
@@ -157,6 +157,7 @@ gui_progbar_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* cons
         }
         case GUI_EVT_SETPARAM: {
             gui_widget_param* v = GUI_EVT_PARAMTYPE_WIDGETPARAM(param);
+            gui_handle_ext_t* ext;
             int32_t tmp;
             switch (v->type) {
                 case CFG_VALUE:
@@ -189,16 +190,16 @@ gui_progbar_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* cons
                     break;
                 case CFG_ANIM:
                     if (*(uint8_t *)v->data) {
-                        if (h->timer == NULL) {
-                            h->timer = guii_timer_create(10, timer_callback, h);    /* Create animation timer */
+                        if (guii_widget_ext(h)->timer == NULL && (ext = guii_widget_ext_create(h)) != NULL) {
+                            ext->timer = guii_timer_create(10, timer_callback, h);  /* Create animation timer */
                         }
-                        if (h->timer != NULL) { /* Check timer response */
+                        if (guii_widget_ext(h)->timer != NULL) { /* Check timer response */
                             o->flags |= GUI_FLAG_PROGBAR_ANIMATE;   /* Enable animations */
                         }
                     } else {
                         o->flags &= ~GUI_FLAG_PROGBAR_ANIMATE;  /* Disable animation */
-                        if (h->timer != NULL) {
-                            guii_timer_remove(&h->timer);   /* Remove timer */
+                        if (guii_widget_ext(h)->timer != NULL) {
+                            guii_timer_remove(&guii_widget_ext_create(h)->timer); /* Remove timer */
                         }
                         set_value(h, o->desiredvalue);  /* Reset value */
                     }
@@ -224,7 +225,7 @@ gui_progbar_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* cons
             gui_draw_rectangle3d(disp, x, y, width, height, GUI_DRAW_3D_State_Lowered);
             
             /* Draw text if possible */
-            if (h->font != NULL) {
+            if (guii_widget_ext(h)->font != NULL) {
                 const gui_char* text = NULL;
                 gui_char buff[5];
                 
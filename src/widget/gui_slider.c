@@ -195,14 +195,18 @@ gui_slider_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
     GUI_ASSERTPARAMS(h != NULL && h->widget == &widget);
     switch (evt) {
         case GUI_EVT_PRE_INIT: {
+            gui_handle_ext_t* ext;
+            
             o->min = 0;                             /* Set default minimal value */
             o->max = 100;                           /* Set default maximal value */
             o->value = 50;                          /* Set default value */
             
             o->max_size = 4;
             o->current_size = 0;
-            h->timer = guii_timer_create(30, timer_callback, o);    /* Create timer for widget, when widget is deleted, timer will be automatically deleted too */
-            if (h->timer == NULL) {                 /* Check if timer created */
+            if ((ext = guii_widget_ext_create(h)) != NULL) {
+                ext->timer = guii_timer_create(30, timer_callback, o);  /* Create timer for widget, when widget is deleted, timer will be automatically deleted too */
+            }
+            if (ext == NULL || ext->timer == NULL) {    /* Check if timer created */
                 GUI_EVT_RESULTTYPE_U8(result) = 0;   /* Failed, widget will be deleted */
             }
             return 1;
@@ -317,7 +321,7 @@ gui_slider_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
             return 1;
 #endif /* GUI_CFG_USE_TOUCH */
         case GUI_EVT_ACTIVEIN: {
-            guii_timer_startperiodic(h->timer);     /* Start animation timer */
+            guii_timer_startperiodic(guii_widget_ext(h)->timer); /* Start animation timer */
             return 1;
         }
         case GUI_EVT_ACTIVEOUT: {
@@ -0,0 +1,377 @@
+/**	
+ * \file            gui_waterfall.c
+ * \brief           Waterfall widget
+ */
+ 
+/*
+ * Copyright (c) 2017 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+#define GUI_INTERNAL
+#include "gui/gui_private.h"
+#include "widget/gui_waterfall.h"
+
+/**
+ * \ingroup         GUI_WATERFALL
+ * \brief           Waterfall object structure
+ */
+typedef struct {
+    gui_handle C;                                   /*!< Global widget object */
+    
+    gui_layer_t* layer;                             /*!< Virtual layer with image, used as ring buffer of rows */
+    gui_dim_t row;                                  /*!< Layer row with newest image row */
+    
+    const gui_color_t* lut;                         /*!< Color look-up table, first entry is used for minimal value */
+    size_t lut_count;                               /*!< Number of entries in look-up table */
+    float min;                                      /*!< Value mapped to first look-up table entry */
+    float scale;                                    /*!< Number of look-up table entries per value unit */
+} gui_waterfall_t;
+
+static uint8_t gui_waterfall_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const param, gui_evt_result_t* const result);
+
+/**
+ * \brief           List of default color in the same order of widget color enumeration
+ */
+static const
+gui_color_t colors[] = {
+    GUI_COLOR_BLACK,                                /*!< Default background color */
+    GUI_COLOR_GRAY,                                 /*!< Default border color */
+};
+
+/**
+ * \brief           Default color look-up table, from low values in dark blue to high values in white
+ */
+static const
+gui_color_t lut_default[] = {
+    0xFF000000, 0xFF000040, 0xFF000080, 0xFF0000C0,
+    0xFF0000FF, 0xFF0040FF, 0xFF0080FF, 0xFF00C0FF,
+    0xFF00FFFF, 0xFF40FFC0, 0xFF80FF80, 0xFFC0FF40,
+    0xFFFFFF00, 0xFFFFC000, 0xFFFF8000, 0xFFFF4000,
+    0xFFFF0000, 0xFFFF4040, 0xFFFF8080, 0xFFFFFFFF,
+};
+
+/**
+ * \brief           Widget initialization structure
+ */
+static const
+gui_widget_t widget = {
+    .name = _GT("WATERFALL"),                       /*!< Widget name */ 
+    .size = sizeof(gui_waterfall_t),                /*!< Size of widget for memory allocation */
+    .flags = 0,                                     /*!< List of widget flags */
+    .callback = gui_waterfall_callback,             /*!< Control function */
+    .colors = colors,                               /*!< List of default colors */
+    .color_count = GUI_COUNT_OF(colors),            /*!< Number of colors */
+};
+
+/**
+ * \brief           Set value range mapped to look-up table
+ * \param[in]       o: Waterfall object
+ * \param[in]       min: Value mapped to first entry
+ * \param[in]       max: Value mapped to last entry
+ */
+static void
+waterfall_setrange(gui_waterfall_t* o, float min, float max) {
+    o->min = min;
+    o->scale = (float)(o->lut_count - 1) / (max - min);
+}
+
+/**
+ * \brief           Allocate image layer for current widget size
+ *
+ *                  New image is filled with background color.
+ *                  When widget size changed, previous rows are lost
+ *
+ * \param[in]       h: Widget handle
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+waterfall_alloc(gui_handle_p h) {
+    gui_waterfall_t* o = GUI_VP(h);
+    gui_dim_t width, height;
+    
+    width = gui_widget_getwidth(h) - 2;             /* Image is inside border */
+    height = gui_widget_getheight(h) - 2;
+    if (width <= 0 || height <= 0) {
+        return 0;
+    }
+    if (o->layer != NULL && o->layer->width == width && o->layer->height == height) {
+        return 1;                                   /* Layer is ready */
+    }
+    
+    if (o->layer != NULL) {
+        GUI_MEMFREE(o->layer);
+    }
+    o->layer = GUI_MEMALLOC_CLASS(sizeof(*o->layer) + (size_t)width * (size_t)height * (size_t)GUI.lcd.pixel_size,
+        GUI_MEM_CLASS_BULK | GUI_MEM_CLASS_DMA);    /* Layer is copied to display with accelerator */
+    if (o->layer == NULL) {
+        return 0;
+    }
+    o->layer->width = width;
+    o->layer->height = height;
+    o->layer->start_address = ((uint8_t *)o->layer) + sizeof(*o->layer);
+    o->row = 0;
+    GUI.ll.FillRect(&GUI.lcd, o->layer, 0, 0, width, height, guii_widget_getcolor(h, GUI_WATERFALL_COLOR_BG));
+    return 1;
+}
+
+/**
+ * \brief           Draw new row to image layer
+ *
+ *                  Values are spread over image width, when multiple values share the same column,
+ *                  maximal value is used. Neighbour columns with the same color are drawn as one line
+ *
+ * \param[in]       o: Waterfall object
+ * \param[in]       values: Row values
+ * \param[in]       count: Number of values
+ */
+static void
+waterfall_drawrow(gui_waterfall_t* o, const float* values, size_t count) {
+    gui_color_t color, run_color = 0;
+    gui_dim_t x, run_x = 0, width = o->layer->width;
+    size_t i, start = 0, end;
+    int32_t index;
+    float v;
+    
+    for (x = 0; x < width; x++, start = end) {
+        end = ((size_t)(x + 1) * count) / (size_t)width;    /* Values covered by column */
+        v = values[start < count ? start : count - 1];
+        for (i = start + 1; i < end; i++) {
+            if (values[i] > v) {
+                v = values[i];
+            }
+        }
+        
+        /* Map value to color */
+        index = (int32_t)((v - o->min) * o->scale);
+        index = GUI_MAX(index, 0);
+        index = GUI_MIN(index, (int32_t)o->lut_count - 1);
+        color = o->lut[index];
+        
+        if (x > 0 && color != run_color) {          /* Draw finished line of equal colors */
+            GUI.ll.DrawHLine(&GUI.lcd, o->layer, run_x, o->row, x - run_x, run_color);
+            run_x = x;
+        }
+        run_color = color;
+    }
+    GUI.ll.DrawHLine(&GUI.lcd, o->layer, run_x, o->row, width - run_x, run_color);
+}
+
+/**
+ * \brief           Copy continuous rows of image layer to screen
+ * \param[in]       disp: Display region for drawing
+ * \param[in]       layer: Image layer
+ * \param[in]       x: Screen X position of image
+ * \param[in]       y: Screen Y position of first row
+ * \param[in]       row: First layer row to copy
+ * \param[in]       rows: Number of rows to copy
+ */
+static void
+waterfall_blit(const gui_display_t* disp, gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_dim_t row, gui_dim_t rows) {
+    gui_layer_t* dl = GUI.lcd.drawing_layer;
+    gui_dim_t x1, y1, x2, y2, i, k;
+    
+    x1 = GUI_MAX(disp->x1, x);
+    y1 = GUI_MAX(disp->y1, y);
+    x2 = GUI_MIN(disp->x2, x + layer->width);
+    y2 = GUI_MIN(disp->y2, y + rows);
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+    row += y1 - y;                                  /* First visible row */
+    
+    if (GUI.ll.Copy != NULL) {
+        GUI.ll.Copy(&GUI.lcd, dl,
+            (void *)(((uint8_t *)dl->start_address) + GUI.lcd.pixel_size * ((y1 - dl->y_pos) * dl->width + (x1 - dl->x_pos))), /* Destination address */
+            (void *)(((uint8_t *)layer->start_address) + GUI.lcd.pixel_size * (row * layer->width + (x1 - x))),  /* Source address */
+            x2 - x1,                                /* Area width */
+            y2 - y1,                                /* Area height */
+            dl->width - (x2 - x1),                  /* Offline destination */
+            layer->width - (x2 - x1)                /* Offline source */
+        );
+    } else {                                        /* Copy pixel by pixel */
+        for (k = y1; k < y2; k++, row++) {
+            for (i = x1; i < x2; i++) {
+                gui_draw_setpixel(disp, i, k, GUI.ll.GetPixel(&GUI.lcd, layer, i - x, row));
+            }
+        }
+    }
+}
+
+/**
+ * \brief           Default widget callback function
+ * \param[in]       h: Widget handle
+ * \param[in]       evt: Event type
+ * \param[in]       param: Input parameters for callback type
+ * \param[out]      result: Result for callback type
+ * \return          `1` if command processed, `0` otherwise
+ */
+static uint8_t
+gui_waterfall_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const param, gui_evt_result_t* const result) {
+    gui_waterfall_t* o = GUI_VP(h);
+    GUI_ASSERTPARAMS(h != NULL && h->widget == &widget);
+    switch (evt) {
+        case GUI_EVT_PRE_INIT: {
+            o->lut = lut_default;                   /* Set default look-up table */
+            o->lut_count = GUI_COUNT_OF(lut_default);
+            waterfall_setrange(o, 0, 100);
+            return 1;
+        }
+        case GUI_EVT_DRAW: {
+            gui_display_t* disp = GUI_EVT_PARAMTYPE_DISP(param);
+            gui_dim_t x, y, width, height, rows;
+            
+            x = gui_widget_getabsolutex(h);         /* Get absolute position on screen */
+            y = gui_widget_getabsolutey(h);         /* Get absolute position on screen */
+            width = gui_widget_getwidth(h);
+            height = gui_widget_getheight(h);
+            
+            gui_draw_rectangle(disp, x, y, width, height, guii_widget_getcolor(h, GUI_WATERFALL_COLOR_BORDER));
+            if (!waterfall_alloc(h)) {
+                gui_draw_filledrectangle(disp, x + 1, y + 1, width - 2, height - 2, guii_widget_getcolor(h, GUI_WATERFALL_COLOR_BG));
+                return 1;
+            }
+            
+            /*
+             * Newest row is on top. Rows are stored in ring buffer,
+             * thus image is copied in 2 parts without moving any pixel in layer
+             */
+            rows = o->layer->height - o->row;
+            waterfall_blit(disp, o->layer, x + 1, y + 1, o->row, rows);
+            waterfall_blit(disp, o->layer, x + 1, y + 1 + rows, 0, o->row);
+            return 1;
+        }
+        case GUI_EVT_REMOVE: {
+            if (o->layer != NULL) {
+                GUI_MEMFREE(o->layer);              /* Free image memory */
+            }
+            return 1;
+        }
+        default:                                    /* Handle default option */
+            GUI_UNUSED3(h, param, result);          /* Unused elements to prevent compiler warnings */
+            return 0;                               /* Command was not processed */
+    }
+}
+
+/**
+ * \brief           Create new waterfall widget
+ * \param[in]       id: Widget unique ID to use for identity for callback processing
+ * \param[in]       x: Widget `X` position relative to parent widget
+ * \param[in]       y: Widget `Y` position relative to parent widget
+ * \param[in]       width: Widget width in units of pixels
+ * \param[in]       height: Widget height in units of pixels
+ * \param[in]       parent: Parent widget handle. Set to `NULL` to use current active parent widget
+ * \param[in]       evt_fn: Custom widget callback function. Set to `NULL` to use default callback
+ * \param[in]       flags: flags for widget creation
+ * \return          Widget handle on success, `NULL` otherwise
+ */
+gui_handle_p
+gui_waterfall_create(gui_id_t id, float x, float y, float width, float height, gui_handle_p parent, gui_widget_evt_fn evt_fn, uint16_t flags) {
+    return (gui_handle_p)gui_widget_create(&widget, id, x, y, width, height, parent, evt_fn, flags);
+}
+
+/**
+ * \brief           Set color to specific part of widget
+ * \param[in]       h: Widget handle
+ * \param[in]       index: Color index
+ * \param[in]       color: Color value
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_waterfall_setcolor(gui_handle_p h, gui_waterfall_color_t index, gui_color_t color) {
+    return gui_widget_setcolor(h, (uint8_t)index, color);
+}
+
+/**
+ * \brief           Set range of values mapped to colors
+ * \note            Only new rows use new range, rows already in image are not changed
+ * \param[in]       h: Widget handle
+ * \param[in]       min: Value with first color of look-up table. Lower values use the same color
+ * \param[in]       max: Value with last color of look-up table. Higher values use the same color
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_waterfall_setrange(gui_handle_p h, float min, float max) {
+    GUI_ASSERTPARAMS(h != NULL && h->widget == &widget && max > min);
+    waterfall_setrange(GUI_VP(h), min, max);
+    return 1;
+}
+
+/**
+ * \brief           Set color look-up table to map values to colors
+ *
+ *                  Table is not copied and must stay valid while widget exists.
+ *                  Value range is split to equal parts, one per table entry
+ *
+ * \note            Only new rows use new table, rows already in image are not changed
+ * \param[in]       h: Widget handle
+ * \param[in]       lut: Array of colors, first is used for minimal value. Set to `NULL` to use default table
+ * \param[in]       count: Number of colors in array
+ * \return          `1` on success, `0` otherwise
+ * \sa              gui_waterfall_setrange
+ */
+uint8_t
+gui_waterfall_setlut(gui_handle_p h, const gui_color_t* lut, size_t count) {
+    gui_waterfall_t* o = GUI_VP(h);
+    float max;
+    
+    GUI_ASSERTPARAMS(h != NULL && h->widget == &widget && (lut == NULL || count > 1));
+    
+    max = o->min + (float)(o->lut_count - 1) / o->scale;    /* Keep value range */
+    if (lut == NULL) {
+        lut = lut_default;
+        count = GUI_COUNT_OF(lut_default);
+    }
+    o->lut = lut;
+    o->lut_count = count;
+    waterfall_setrange(o, o->min, max);
+    return 1;
+}
+
+/**
+ * \brief           Add new row of values to the top of waterfall
+ *
+ *                  Oldest row at the bottom is removed. Only new row is drawn,
+ *                  other rows stay in image memory and are not touched
+ *
+ * \param[in]       h: Widget handle
+ * \param[in]       values: Array of values, spread over whole widget width
+ * \param[in]       count: Number of values in array
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_waterfall_addrow(gui_handle_p h, const float* values, size_t count) {
+    gui_waterfall_t* o = GUI_VP(h);
+    
+    GUI_ASSERTPARAMS(h != NULL && h->widget == &widget && values != NULL && count > 0);
+    
+    if (!waterfall_alloc(h)) {
+        return 0;
+    }
+    o->row = o->row == 0 ? o->layer->height - 1 : o->row - 1;   /* Oldest row becomes newest */
+    waterfall_drawrow(o, values, count);
+    gui_widget_invalidate(h);                       /* Redraw widget */
+    return 1;
+}
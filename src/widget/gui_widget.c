@@ -36,12 +36,11 @@
 #include "widget/gui_window.h"
 
 /**
- * \brief           Default widget settings
+ * \brief           Default rarely used values of widget
+ *
+ *                  Widgets without own values read these, own values of widget start as their copy
  */
-typedef struct {
-    const gui_font_t* font;                 /*!< Pointer to font structure */
-} gui_widget_default_t;
-gui_widget_default_t widget_default;
+gui_handle_ext_t guii_widget_ext_default;
 
 /* Widget absolute cache setup */
 #if GUI_CFG_USE_POS_SIZE_CACHE
@@ -107,7 +106,7 @@ calculate_widget_absolute_x(gui_handle_p h) {
     for (w = guii_widget_getparent(h); w != NULL;
         w = guii_widget_getparent(w)) {             /* Go through all parent windows */
         out += guii_widget_getrelativex(w) + gui_widget_getpaddingleft(w);  /* Add X offset from parent and left padding of parent */
-        out -= w->x_scroll;                         /* Decrease by scroll value */
+        out -= guii_widget_ext(w)->x_scroll;        /* Decrease by scroll value */
     }
     return out;
 }
@@ -132,7 +131,7 @@ calculate_widget_absolute_y(gui_handle_p h) {
     for (w = guii_widget_getparent(h); w != NULL;
         w = guii_widget_getparent(w)) {             /* Go through all parent windows */
         out += guii_widget_getrelativey(w) + gui_widget_getpaddingtop(w);   /* Add Y offset from parent and top padding of parent */
-        out -= w->y_scroll;                         /* Decrease by scroll value */
+        out -= guii_widget_ext(w)->y_scroll;        /* Decrease by scroll value */
     }
     return out;
 }
@@ -208,6 +207,69 @@ set_widget_abs_values(gui_handle_p h) {
 }
 #endif /* GUI_CFG_USE_POS_SIZE_CACHE */
 
+/**
+ * \brief           Free timer, custom colors and rarely used values of widget
+ * \param[in]       h: Widget handle
+ */
+static void
+free_widget_ext(gui_handle_p h) {
+    gui_handle_ext_t* ext;
+    
+#if GUI_CFG_WIDGET_LAZY_EXT
+    if (h->ext == NULL) {                           /* Widget has only default values */
+        return;
+    }
+#endif /* GUI_CFG_WIDGET_LAZY_EXT */
+    ext = guii_widget_ext_create(h);
+    if (ext->timer != NULL) {
+        guii_timer_remove(&ext->timer);
+    }
+    if (ext->colors != NULL) {
+        GUI_MEMFREE(ext->colors);
+    }
+#if GUI_CFG_WIDGET_LAZY_EXT
+    GUI_POOLFREE(h->ext, sizeof(*h->ext));
+#endif /* GUI_CFG_WIDGET_LAZY_EXT */
+}
+
+/**
+ * \brief           Allocate memory for new widget
+ * \note            While widget tree is created, memory is taken from its static memory block
+ * \param[in]       widget: Widget description
+ * \return          Widget handle with memory set to zero on success, `NULL` otherwise
+ */
+static gui_handle_p
+alloc_widget(const gui_widget_t* widget) {
+#if GUI_CFG_USE_WIDGET_TREE
+    gui_handle_p h;
+    size_t size = GUI_MEM_ALIGN((size_t)widget->size);
+    
+    if (GUI.widget_block.mem != NULL) {             /* Widget tree is being created */
+        if (size > GUI.widget_block.size) {         /* Not enough memory in block */
+            return NULL;
+        }
+        h = (gui_handle_p)GUI.widget_block.mem;
+        GUI.widget_block.mem += size;
+        GUI.widget_block.size -= size;
+        memset(h, 0x00, size);
+        guii_widget_setflag(h, GUI_FLAG_STATIC_MEMORY); /* Memory must not be freed */
+        return h;
+    }
+#endif /* GUI_CFG_USE_WIDGET_TREE */
+    return GUI_POOLALLOC(widget->size);
+}
+
+/**
+ * \brief           Free memory of widget
+ * \param[in]       h: Widget handle
+ */
+static void
+free_widget(gui_handle_p h) {
+    if (!guii_widget_getflag(h, GUI_FLAG_STATIC_MEMORY)) {
+        GUI_POOLFREE(h, h->widget->size);
+    }
+}
+
 /**
  * \brief           Remove widget from memory
  * \param[in]       h: Widget handle
@@ -259,15 +321,9 @@ remove_widget(gui_handle_p h) {
      */
     gui_widget_invalidatewithparent(h);
     gui_widget_freetextmemory(h);
-    if (h->timer != NULL) {
-        guii_timer_remove(&h->timer);
-    }
-    if (h->colors != NULL) {
-        GUI_MEMFREE(h->colors);
-        h->colors = NULL;
-    }
+    free_widget_ext(h);                             /* Remove timer and custom colors */
     gui_linkedlist_widgetremove(h);                 /* Remove entry from linked list of parent widget */
-    GUI_MEMFREE(h);                                 /* Free memory for widget */
+    free_widget(h);                                 /* Free memory for widget */
     
     return 1;                                       /* Widget deleted */
 }
@@ -392,6 +448,22 @@ set_clipping_region(gui_handle_p h) {
     return 1;
 }
 
+/**
+ * \brief           Notify all parent widgets that widget needs redraw
+ *
+ *                  Redraw process descends only to widgets with \ref GUI_FLAG_CHILD_REDRAW flag set,
+ *                  thus clean parts of tree are not visited at all
+ * \param[in]       h: Widget handle which needs redraw
+ */
+static void
+set_parents_child_redraw(gui_handle_p h) {
+    /* When flag is already set on parent, it is set on all its parents too */
+    for (h = guii_widget_getparent(h); h != NULL && !guii_widget_getflag(h, GUI_FLAG_CHILD_REDRAW);
+        h = guii_widget_getparent(h)) {
+        guii_widget_setflag(h, GUI_FLAG_CHILD_REDRAW);
+    }
+}
+
 /**
  * \brief           Invalidate widget and set redraw flag
  * \note            If widget is transparent, parent must be updated too. This function will handle these cases.
@@ -433,6 +505,7 @@ invalidate_widget(gui_handle_p h, uint8_t setclipping) {
         
     h1 = h;                                         /* Save temporary */
     guii_widget_setflag(h1, GUI_FLAG_REDRAW);       /* Redraw widget */
+    set_parents_child_redraw(h1);                   /* Notify parents, siblings share the same parent */
     GUI.flags |= GUI_FLAG_REDRAW;                   /* Notify stack about redraw operations */
     
     if (setclipping) {
@@ -530,6 +603,32 @@ get_widget_by_id(gui_handle_p parent, gui_id_t id, uint8_t deep) {
     return NULL;
 }
 
+#if GUI_CFG_WIDGET_LAZY_EXT || __DOXYGEN__
+
+/**
+ * \brief           Allocate rarely used values for widgets which use default values
+ *
+ *                  Widgets keep values they were created with when default values change
+ * \param[in]       parent: Parent widget handle. Set to `NULL` to process all widgets
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+ext_snapshot(gui_handle_p parent) {
+    gui_handle_p h;
+    
+    GUI_LINKEDLIST_WIDGETSLISTNEXT(parent, h) {
+        if (guii_widget_ext_create(h) == NULL) {    /* Copy current default values */
+            return 0;
+        }
+        if (guii_widget_haschildren(h) && !ext_snapshot(h)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#endif /* GUI_CFG_WIDGET_LAZY_EXT || __DOXYGEN__ */
+
 /**
  * \brief           Get first common widget between 2 widgets in a tree
  * \param[in]       h1: First widget handle
@@ -549,7 +648,7 @@ get_common_parentwidget(gui_handle_p h1, gui_handle_p h2) {
             }
         }
     }
-    return GUI.root.first;                          /* Return bottom widget on list */
+    return gui_linkedlist_widgetgetnext(NULL, NULL); /* Return bottom widget on list */
 }
 
 /**
@@ -773,6 +872,31 @@ guii_widget_init(void) {
     gui_window_createdesktop(GUI_ID_WINDOW_BASE, NULL);     /* Create base window object */
 }
 
+/**
+ * \brief           Get rarely used values of widget for writing
+ *
+ *                  When \ref GUI_CFG_WIDGET_LAZY_EXT is enabled, values are allocated on first call
+ *                  as copy of default values
+ *
+ * \note            The function is private and can be called only when GUI protection against multiple access is activated
+ * \param[in]       h: Widget handle
+ * \return          Pointer to values on success, `NULL` otherwise
+ */
+gui_handle_ext_t*
+guii_widget_ext_create(gui_handle_p h) {
+#if GUI_CFG_WIDGET_LAZY_EXT
+    if (h->ext == NULL) {
+        h->ext = GUI_POOLALLOC(sizeof(*h->ext));
+        if (h->ext != NULL) {
+            memcpy(h->ext, &guii_widget_ext_default, sizeof(*h->ext));
+        }
+    }
+    return h->ext;
+#else /* GUI_CFG_WIDGET_LAZY_EXT */
+    return &h->ext;
+#endif /* !GUI_CFG_WIDGET_LAZY_EXT */
+}
+
 /**
  * \brief           Execute remove, check all widgets with remove status
  * \return          `1` on success, `0` otherwise
@@ -787,6 +911,28 @@ guii_widget_executeremove(void) {
     return 0;
 }
 
+/**
+ * \brief           Remove widget and all its children immediately
+ *
+ *                  Unlike \ref gui_widget_remove, widgets are not only marked for removal,
+ *                  they are removed from tree and their memory is released before function returns
+ * \param[in]       h: Widget handle
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+guii_widget_removenow(gui_handle_p h) {
+    gui_handle_p child;
+    
+    GUI_ASSERTPARAMS(guii_widget_iswidget(h));
+    
+    if (guii_widget_haschildren(h)) {
+        while ((child = gui_linkedlist_widgetgetnext(h, NULL)) != NULL) {
+            guii_widget_removenow(child);           /* Remove children first */
+        }
+    }
+    return remove_widget(h);
+}
+
 /**
  * \brief           Move widget down on linked list (put it as last, most visible on screen)
  * \param[in]       h: Widget handle
@@ -824,14 +970,16 @@ guii_widget_movedowntree(gui_handle_p h) {
  */
 void
 guii_widget_focus_clear(void) {
-    if (GUI.focused_widget != NULL && GUI.focused_widget != GUI.root.first) { /* First widget is always in focus */
+    gui_handle_p first = gui_linkedlist_widgetgetnext(NULL, NULL);
+    
+    if (GUI.focused_widget != NULL && GUI.focused_widget != first) {  /* First widget is always in focus */
         GUI.focused_widget_prev = GUI.focused_widget;   /* Clear everything */
         do {
             guii_widget_callback(GUI.focused_widget, GUI_EVT_FOCUSOUT, NULL, NULL);
             guii_widget_clrflag(GUI.focused_widget, GUI_FLAG_FOCUS);
             gui_widget_invalidate(GUI.focused_widget);
             GUI.focused_widget = guii_widget_getparent(GUI.focused_widget);
-        } while (GUI.focused_widget != GUI.root.first); /* Loop to the bottom */
+        } while (GUI.focused_widget != first);          /* Loop to the bottom */
         GUI.focused_widget = NULL;                  /* Reset focused widget */
     }
 }
@@ -870,7 +1018,7 @@ guii_widget_focus_set(gui_handle_p h) {
             }
         }
     } else {
-        common = GUI.root.first;                    /* Get bottom widget */
+        common = gui_linkedlist_widgetgetnext(NULL, NULL); /* Get bottom widget */
     }
     
     /*
@@ -1113,7 +1261,7 @@ gui_widget_create(const gui_widget_t* widget, gui_id_t id, float x, float y, flo
         return 0;
     }
 
-    h = GUI_MEMALLOC(widget->size);                 /* Allocate memory for widget */
+    h = alloc_widget(widget);                       /* Allocate memory for widget */
     if (h != NULL) {
         gui_evt_param_t param = {0};
         gui_evt_result_t result = {0};
@@ -1121,6 +1269,9 @@ gui_widget_create(const gui_widget_t* widget, gui_id_t id, float x, float y, flo
         h->id = id;                                 /* Save ID */
         h->widget = widget;                         /* Widget object structure */
         h->footprint = GUI_WIDGET_FOOTPRINT;        /* Set widget footprint */
+#if !GUI_CFG_WIDGET_LAZY_EXT
+        h->ext = guii_widget_ext_default;           /* Set default values, such as font */
+#endif /* !GUI_CFG_WIDGET_LAZY_EXT */
         h->callback = evt_fn;                       /* Set widget callback */
 #if GUI_CFG_USE_ALPHA
         h->alpha = 0xFF;                            /* Set full transparency by default */
@@ -1150,14 +1301,12 @@ gui_widget_create(const gui_widget_t* widget, gui_id_t id, float x, float y, flo
         guii_widget_callback(h, GUI_EVT_PRE_INIT, NULL, &result);    /* Notify internal widget library about init successful */
         
         if (!GUI_EVT_RESULTTYPE_U8(&result)) {
-            GUI_MEMFREE(h);
+            free_widget_ext(h);
+            free_widget(h);
             h = NULL;
         }
         
         if (h != NULL) {
-            /* Set widget default values */
-            h->font = widget_default.font;          /* Set default font */
-
             /* Do not invalidate widget while setting first size and position */
             guii_widget_setflag(h, GUI_FLAG_FIRST_INVALIDATE);  /* Ignore invalidation process for size and position */
             gui_widget_setsize(h, GUI_DIM(width), GUI_DIM(height)); /* Set widget size */
@@ -1175,8 +1324,12 @@ gui_widget_create(const gui_widget_t* widget, gui_id_t id, float x, float y, flo
             /* Add widget to linked list of parent widget */
             GUI_EVT_RESULTTYPE_U8(&result) = 0;
             guii_widget_callback(h, GUI_EVT_EXCLUDELINKEDLIST, NULL, &result);
-            if (!GUI_EVT_RESULTTYPE_U8(&result)) {   /* Check if widget should be added to linked list */
-                gui_linkedlist_widgetadd(h->parent, h); /* Add entry to linkedlist of parent widget */
+            if (!GUI_EVT_RESULTTYPE_U8(&result)     /* Check if widget should be added to linked list */
+                && !gui_linkedlist_widgetadd(h->parent, h)) {   /* Add entry to linkedlist of parent widget */
+                gui_widget_freetextmemory(h);
+                free_widget_ext(h);
+                free_widget(h);
+                return NULL;
             }
             guii_widget_callback(h, GUI_EVT_INIT, NULL, NULL);  /* Notify user about init successful */
             gui_widget_invalidate(h);               /* Invalidate object */
@@ -1205,15 +1358,19 @@ gui_widget_create(const gui_widget_t* widget, gui_id_t id, float x, float y, flo
  */
 uint8_t
 gui_widget_setcolor(gui_handle_p h, uint8_t index, gui_color_t color) {
+    gui_handle_ext_t* ext;
     uint8_t ret = 1;
     
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
 
-    if (h->colors == NULL) {                        /* Do we need to allocate color memory? */
+    if ((ext = guii_widget_ext_create(h)) == NULL) {
+        return 0;
+    }
+    if (ext->colors == NULL) {                      /* Do we need to allocate color memory? */
         if (h->widget->color_count) {               /* Check if at least some colors should be used */
-            h->colors = GUI_MEMALLOC(sizeof(*h->colors) * h->widget->color_count);
-            if (h->colors != NULL) {                /* Copy all colors to new memory first */
-                memcpy(h->colors, h->widget->colors, sizeof(*h->colors) * h->widget->color_count);
+            ext->colors = GUI_MEMALLOC(sizeof(*ext->colors) * h->widget->color_count);
+            if (ext->colors != NULL) {              /* Copy all colors to new memory first */
+                memcpy(ext->colors, h->widget->colors, sizeof(*ext->colors) * h->widget->color_count);
             } else {
                 ret = 0;
             }
@@ -1223,7 +1380,7 @@ gui_widget_setcolor(gui_handle_p h, uint8_t index, gui_color_t color) {
     }
     if (ret) {
         if (index < h->widget->color_count) {       /* Index in valid range */
-           h->colors[index] = color;                /* Set new color */
+           ext->colors[index] = color;              /* Set new color */
         } else {
             ret = 0;
         }
@@ -1298,7 +1455,76 @@ gui_widget_empty(gui_handle_p h) {
 uint8_t
 gui_widget_isfontandtextset(gui_handle_p h) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-    return h->text != NULL && h->font != NULL && gui_string_length(h->text);    /* Check if conditions are met for drawing string */
+    return guii_widget_ext(h)->text != NULL && guii_widget_ext(h)->font != NULL && gui_string_length(guii_widget_ext(h)->text); /* Check if conditions are met for drawing string */
+}
+
+/**
+ * \brief           Get memory for dynamic text with required size
+ * \note            When \ref GUI_CFG_WIDGET_TEXT_INLINE_SIZE is used and text does not fit to memory inside widget,
+ *                  memory is allocated and current text is moved to it
+ * \param[in]       ext: Widget values with dynamic text
+ * \param[in]       size: Number of bytes required for text, including string termination
+ * \return          Number of bytes available for text
+ */
+static size_t
+widget_text_reserve(gui_handle_ext_t* ext, size_t size) {
+#if GUI_CFG_WIDGET_TEXT_INLINE_SIZE
+    gui_char* text;
+    
+    if (ext->text == ext->text_inline) {            /* Text is inside widget */
+        if (size <= sizeof(ext->text_inline) || ext->textmemsize <= sizeof(ext->text_inline)) {
+            return GUI_MIN(sizeof(ext->text_inline), ext->textmemsize);
+        }
+        text = GUI_MEMALLOC(ext->textmemsize);      /* Allocate full requested memory */
+        if (text == NULL) {                         /* Keep text inside widget */
+            return sizeof(ext->text_inline);
+        }
+        memcpy(text, ext->text_inline, sizeof(ext->text_inline));
+        ext->text = text;
+    }
+#else /* GUI_CFG_WIDGET_TEXT_INLINE_SIZE */
+    GUI_UNUSED(size);
+#endif /* !GUI_CFG_WIDGET_TEXT_INLINE_SIZE */
+    return ext->textmemsize;
+}
+
+/**
+ * \brief           Move short dynamic text back to memory inside widget and free allocated memory
+ * \note            It has effect only when \ref GUI_CFG_WIDGET_TEXT_INLINE_SIZE is used
+ * \param[in]       ext: Widget values with dynamic text
+ */
+static void
+widget_text_shrink(gui_handle_ext_t* ext) {
+#if GUI_CFG_WIDGET_TEXT_INLINE_SIZE
+    size_t size;
+    
+    if (ext->text != ext->text_inline) {
+        size = gui_string_lengthtotal(ext->text) + 1;   /* Number of bytes with termination */
+        if (size <= sizeof(ext->text_inline)) {     /* Text fits to memory inside widget */
+            memcpy(ext->text_inline, ext->text, size);
+            GUI_MEMFREE(ext->text);
+            ext->text = ext->text_inline;
+        }
+    }
+#else /* GUI_CFG_WIDGET_TEXT_INLINE_SIZE */
+    GUI_UNUSED(ext);
+#endif /* !GUI_CFG_WIDGET_TEXT_INLINE_SIZE */
+}
+
+/**
+ * \brief           Free memory for dynamic text
+ * \param[in]       ext: Widget values with dynamic text
+ */
+static void
+widget_text_free(gui_handle_ext_t* ext) {
+#if GUI_CFG_WIDGET_TEXT_INLINE_SIZE
+    if (ext->text != ext->text_inline)
+#endif /* GUI_CFG_WIDGET_TEXT_INLINE_SIZE */
+    {
+        GUI_MEMFREE(ext->text);                     /* Free allocated memory */
+    }
+    ext->text = NULL;
+    ext->textmemsize = 0;
 }
 
 /**
@@ -1314,49 +1540,52 @@ guii_widget_processtextkey(gui_handle_p h, guii_keyboard_data_t* kb) {
     uint32_t ch;
     uint8_t l;
     gui_string_t currStr;
+    gui_handle_ext_t* ext;
     
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
     
     if (!guii_widget_getflag(h, GUI_FLAG_DYNAMICTEXTALLOC)) {  /* Must be dynamically allocated memory */
         return 0;
     }
+    ext = guii_widget_ext_create(h);                /* Values exist when text memory is allocated */
     
     gui_string_prepare(&currStr, kb->kb.keys);      /* Set string to process */
     if (!gui_string_getch(&currStr, &ch, &l)) {     /* Get key from input data */
         return 0;                                   /* Invalid input key */
     }
     
-    tlen = gui_string_lengthtotal(h->text);         /* Get total length of string */
-    len = gui_string_length(h->text);               /* Get string length */
+    tlen = gui_string_lengthtotal(ext->text);       /* Get total length of string */
+    len = gui_string_length(ext->text);             /* Get string length */
     if ((ch == GUI_KEY_LF || ch >= 32) && ch != 127) {  /* Check valid character character */
-        if (len < (h->textmemsize - l)) {           /* Memory still available for new character */
+        if (len < (ext->textmemsize - l)            /* Memory still available for new character */
+            && widget_text_reserve(ext, tlen + l + 1) > tlen + l) {
             size_t pos;
-            for (pos = tlen + l - 1; pos > h->textcursor; pos--) {  /* Shift characters down */
-                h->text[pos] = h->text[pos - l];
+            for (pos = tlen + l - 1; pos > ext->textcursor; pos--) { /* Shift characters down */
+                ext->text[pos] = ext->text[pos - l];
             }
             for (pos = 0; pos < l; pos++) {         /* Fill new characters to empty memory */
-                h->text[h->textcursor++] = kb->kb.keys[pos];
+                ext->text[ext->textcursor++] = kb->kb.keys[pos];
             }
-            h->text[tlen + l] = 0;                  /* Add 0 to the end */
+            ext->text[tlen + l] = 0;                /* Add 0 to the end */
             
             gui_widget_invalidate(h);               /* Invalidate widget */
             guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);   /* Process callback */
             return 1;
         }
     } else if (ch == 8 || ch == 127) {              /* Backspace character */
-        if (tlen && h->textcursor) {
+        if (tlen && ext->textcursor) {
             size_t pos;
             
-            gui_string_prepare(&currStr, (gui_char *)((uint32_t)h->text + h->textcursor - 1));  /* Set string to process */
+            gui_string_prepare(&currStr, (gui_char *)((uint32_t)ext->text + ext->textcursor - 1)); /* Set string to process */
             gui_string_gotoend(&currStr);           /* Go to the end of string */
             if (!gui_string_getchreverse(&currStr, &ch, &l)) {  /* Get last character */
                 return 0;                           
             }
-            for (pos = h->textcursor - l; pos < (tlen - l); pos++) {/* Shift characters up */
-                h->text[pos] = h->text[pos + l];
+            for (pos = ext->textcursor - l; pos < (tlen - l); pos++) {/* Shift characters up */
+                ext->text[pos] = ext->text[pos + l];
             }
-            h->textcursor -= l;                     /* Decrease text cursor by number of bytes for character deleted */
-            h->text[tlen - l] = 0;                  /* Set 0 to the end of string */
+            ext->textcursor -= l;                   /* Decrease text cursor by number of bytes for character deleted */
+            ext->text[tlen - l] = 0;                /* Set 0 to the end of string */
             
             gui_widget_invalidate(h);               /* Invalidate widget */
             guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);/* Process callback */
@@ -1375,26 +1604,35 @@ guii_widget_processtextkey(gui_handle_p h, guii_keyboard_data_t* kb) {
  */
 uint32_t
 gui_widget_alloctextmemory(gui_handle_p h, uint32_t size) {
+    gui_handle_ext_t* ext;
+    
     GUI_ASSERTPARAMS(guii_widget_iswidget(h) && size > 1);   
     
-    if (guii_widget_getflag(h, GUI_FLAG_DYNAMICTEXTALLOC) && h->text != NULL) { /* Check if already allocated */
-        GUI_MEMFREE(h->text);                       /* Free memory first */
-        h->textmemsize = 0;                         /* Reset memory size */
+    if ((ext = guii_widget_ext_create(h)) == NULL) {
+        return 0;
+    }
+    if (guii_widget_getflag(h, GUI_FLAG_DYNAMICTEXTALLOC) && ext->text != NULL) {   /* Check if already allocated */
+        widget_text_free(ext);                      /* Free memory first */
     }
-    h->text = NULL;                                 /* Reset pointer */
+    ext->text = NULL;                               /* Reset pointer */
 
-    h->textmemsize = sizeof(gui_char) * (size + 1); /* Allocate text memory */
-    h->text = GUI_MEMALLOC(h->textmemsize);
-    if (h->text != NULL) {                          /* Check if allocated */
+    ext->textmemsize = sizeof(gui_char) * (size + 1); /* Allocate text memory */
+#if GUI_CFG_WIDGET_TEXT_INLINE_SIZE
+    memset(ext->text_inline, 0x00, sizeof(ext->text_inline));
+    ext->text = ext->text_inline;                   /* Use memory inside widget until text is longer */
+#else /* GUI_CFG_WIDGET_TEXT_INLINE_SIZE */
+    ext->text = GUI_MEMALLOC(ext->textmemsize);
+#endif /* !GUI_CFG_WIDGET_TEXT_INLINE_SIZE */
+    if (ext->text != NULL) {                        /* Check if allocated */
         guii_widget_setflag(h, GUI_FLAG_DYNAMICTEXTALLOC); /* Dynamically allocated */
     } else {
-        h->textmemsize = 0;                         /* No dynamic bytes available */
+        ext->textmemsize = 0;                       /* No dynamic bytes available */
         guii_widget_clrflag(h, GUI_FLAG_DYNAMICTEXTALLOC); /* Not allocated */
     }
     gui_widget_invalidate(h);                       /* Redraw object */
     guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);   /* Process callback */
     
-    return h->textmemsize;                          /* Return number of bytes allocated */
+    return ext->textmemsize;                        /* Return number of bytes allocated */
 }
 
 /**
@@ -1404,14 +1642,14 @@ gui_widget_alloctextmemory(gui_handle_p h, uint32_t size) {
  */
 uint8_t
 gui_widget_freetextmemory(gui_handle_p h) {
+    gui_handle_ext_t* ext;
     uint8_t res = 0;
     
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
     
-    if (guii_widget_getflag(h, GUI_FLAG_DYNAMICTEXTALLOC) && h->text != NULL) { /* Check if dynamically alocated */
-        GUI_MEMFREE(h->text);                       /* Free memory first */
-        h->text = NULL;                             /* Reset memory */
-        h->textmemsize = 0;                         /* Reset memory size */
+    if (guii_widget_getflag(h, GUI_FLAG_DYNAMICTEXTALLOC) && guii_widget_ext(h)->text != NULL) {  /* Check if dynamically alocated */
+        ext = guii_widget_ext_create(h);            /* Values exist when text memory is allocated */
+        widget_text_free(ext);                      /* Free memory and reset memory size */
         guii_widget_clrflag(h, GUI_FLAG_DYNAMICTEXTALLOC); /* Not allocated */
         gui_widget_invalidate(h);                   /* Redraw object */
         guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);   /* Process callback */
@@ -1432,31 +1670,39 @@ gui_widget_freetextmemory(gui_handle_p h) {
  */
 uint8_t
 gui_widget_settext(gui_handle_p h, const gui_char* text) {
+    gui_handle_ext_t* ext;
+    size_t size;
+    
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
     
+    if ((ext = guii_widget_ext_create(h)) == NULL) {
+        return 0;
+    }
     if (guii_widget_getflag(h, GUI_FLAG_DYNAMICTEXTALLOC)) {   /* Memory for text is dynamically allocated */
-        if (h->textmemsize) {
-            if (gui_string_lengthtotal(text) > (h->textmemsize - 1)) {  /* Check string length */
-                gui_string_copyn(h->text, text, h->textmemsize - 1);    /* Do not copy all bytes because of memory overflow */
+        if (ext->textmemsize) {
+            size = widget_text_reserve(ext, gui_string_lengthtotal(text) + 1);  /* Get memory for new text */
+            if (gui_string_lengthtotal(text) > (size - 1)) {  /* Check string length */
+                gui_string_copyn(ext->text, text, size - 1);  /* Do not copy all bytes because of memory overflow */
             } else {
-                gui_string_copy(h->text, text);     /* Copy entire string */
+                gui_string_copy(ext->text, text);   /* Copy entire string */
             }
+            widget_text_shrink(ext);                /* Release memory if text is short */
             gui_widget_invalidate(h);               /* Redraw object */
             guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);   /* Process callback */
         }
     } else {                                        /* Memory allocated by user */
-        if (h->text != NULL && h->text == text) {   /* In case the same pointer is passed to WIDGET */
+        if (ext->text != NULL && ext->text == text) { /* In case the same pointer is passed to WIDGET */
             gui_widget_invalidate(h);               /* Redraw object */
             guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);   /* Process callback */
         }
         
-        if (h->text != text) {                      /* Check if pointer do not match */
-            h->text = (gui_char *)text;             /* Set parameter */
+        if (ext->text != text) {                    /* Check if pointer do not match */
+            ext->text = (gui_char *)text;           /* Set parameter */
             gui_widget_invalidate(h);               /* Redraw object */
             guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);   /* Process callback */
         }
     }
-    h->textcursor = gui_string_lengthtotal(h->text);/* Set cursor to the end of string */
+    ext->textcursor = gui_string_lengthtotal(ext->text);    /* Set cursor to the end of string */
     
     return 1;
 }
@@ -1475,12 +1721,12 @@ gui_widget_gettext(gui_handle_p h) {
     
 #if GUI_CFG_USE_TRANSLATE
     /* For static texts only */
-    if (!guii_widget_getflag(h, GUI_FLAG_DYNAMICTEXTALLOC) && h->text != NULL) {
-        t = gui_translate_get(h->text);             /* Get translation entry */
+    if (!guii_widget_getflag(h, GUI_FLAG_DYNAMICTEXTALLOC) && guii_widget_ext(h)->text != NULL) {
+        t = gui_translate_get(guii_widget_ext(h)->text); /* Get translation entry */
     } else 
 #endif /* GUI_CFG_USE_TRANSLATE */
     { 
-        t = h->text;                                /* Get text for widget */
+        t = guii_widget_ext(h)->text;               /* Get text for widget */
     }
     
     return t;
@@ -1515,10 +1761,15 @@ gui_widget_gettextcopy(gui_handle_p h, gui_char* dst, uint32_t len) {
  */
 uint8_t
 gui_widget_setfont(gui_handle_p h, const gui_font_t* font) {
+    gui_handle_ext_t* ext;
+    
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
     
-    if (h->font != font) {
-        h->font = font;
+    if (guii_widget_ext(h)->font != font) {
+        if ((ext = guii_widget_ext_create(h)) == NULL) {
+            return 0;
+        }
+        ext->font = font;
         gui_widget_invalidatewithparent(h);
     }
     
@@ -1534,7 +1785,7 @@ gui_widget_setfont(gui_handle_p h, const gui_font_t* font) {
 const gui_font_t *
 gui_widget_getfont(gui_handle_p h) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-    return h->font;                                 /* Get widget font */
+    return guii_widget_ext(h)->font;                /* Get widget font */
 }
 
 /***************************************************************/
@@ -2035,6 +2286,51 @@ gui_widget_invalidate(gui_handle_p h) {
     return res;
 }
 
+/**
+ * \brief           Invalidate part of widget object and prepare to new redraw
+ *
+ *                  Widget is redrawn the same way as with \ref gui_widget_invalidate,
+ *                  but clipping region is expanded only by selected area.
+ *                  Widget may use it to redraw only part which changed
+ *
+ * \param[in]       h: Widget handle
+ * \param[in]       x1, y1, x2, y2: Absolute area on screen to redraw, end positions are not included
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+guii_widget_invalidaterect(gui_handle_p h, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2) {
+    gui_dim_t vx1, vy1, vx2, vy2;
+    uint8_t res = 0;
+    
+    GUI_ASSERTPARAMS(guii_widget_iswidget(h));     
+    
+    if (!guii_widget_getflag(h, GUI_FLAG_IGNORE_INVALIDATE)) {
+        res = invalidate_widget(h, 0);              /* Invalidate widget without clipping */
+        
+        /* Expand clipping region by visible part of area only */
+        get_widget_abs_visible_position_size(h, &vx1, &vy1, &vx2, &vy2);
+        x1 = GUI_MAX(x1, vx1);
+        y1 = GUI_MAX(y1, vy1);
+        x2 = GUI_MIN(x2, vx2);
+        y2 = GUI_MIN(y2, vy2);
+        if (x1 < x2 && y1 < y2) {
+            if (GUI.display.x1 > x1)    { GUI.display.x1 = x1; }
+            if (GUI.display.x2 < x2)    { GUI.display.x2 = x2; }
+            if (GUI.display.y1 > y1)    { GUI.display.y1 = y1; }
+            if (GUI.display.y2 < y2)    { GUI.display.y2 = y2; }
+        }
+        if (guii_widget_hasparent(h) && (
+                guii_widget_getflag(h, GUI_FLAG_WIDGET_INVALIDATE_PARENT) || 
+                guii_widget_getcoreflag(h, GUI_FLAG_WIDGET_INVALIDATE_PARENT) ||
+                guii_widget_hasalpha(h)             /* At least little alpha */
+            )) {
+            invalidate_widget(guii_widget_getparent(h), 0); /* Invalidate parent object too but without clipping */
+        }
+    }
+    
+    return res;
+}
+
 uint8_t
 gui_widget_force_invalidate(gui_handle_p h) {
     /* TODO: Clear ignore invalidate flag, invalidate, set it back (if it was set before clearing it) */
@@ -2236,8 +2532,15 @@ gui_widget_ischildof(gui_handle_p h, gui_handle_p parent) {
  */
 uint8_t
 gui_widget_setuserdata(gui_handle_p h, void* const data) {
+    gui_handle_ext_t* ext;
+    
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-    h->arg = data;                                  /* Set user argument */
+    if (guii_widget_ext(h)->arg != data) {
+        if ((ext = guii_widget_ext_create(h)) == NULL) {
+            return 0;
+        }
+        ext->arg = data;                            /* Set user argument */
+    }
     return 1;
 }
 
@@ -2249,7 +2552,7 @@ gui_widget_setuserdata(gui_handle_p h, void* const data) {
 void*
 gui_widget_getuserdata(gui_handle_p h) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-    return h->arg;                                  /* Get user argument */
+    return guii_widget_ext(h)->arg;                 /* Get user argument */
 }
 
 /**
@@ -2311,12 +2614,13 @@ gui_widget_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
  */
 uint8_t
 gui_widget_setscrollx(gui_handle_p h, gui_dim_t scroll) {
+    gui_handle_ext_t* ext;
     uint8_t ret = 0;
     
     GUI_ASSERTPARAMS(guii_widget_iswidget(h) && guii_widget_allowchildren(h));
     
-    if (h->x_scroll != scroll) {
-        h->x_scroll = scroll;
+    if (guii_widget_ext(h)->x_scroll != scroll && (ext = guii_widget_ext_create(h)) != NULL) {
+        ext->x_scroll = scroll;
         SET_WIDGET_ABS_VALUES(h);                   /* Set new absolute values */
         gui_widget_invalidate(h);                   /* Invalidate widget */
         ret = 1;
@@ -2333,12 +2637,13 @@ gui_widget_setscrollx(gui_handle_p h, gui_dim_t scroll) {
  */
 uint8_t
 gui_widget_setscrolly(gui_handle_p h, gui_dim_t scroll) {
+    gui_handle_ext_t* ext;
     uint8_t ret = 0;
     
     GUI_ASSERTPARAMS(guii_widget_iswidget(h) && guii_widget_allowchildren(h));
     
-    if (h->y_scroll != scroll) {
-        h->y_scroll = scroll;
+    if (guii_widget_ext(h)->y_scroll != scroll && (ext = guii_widget_ext_create(h)) != NULL) {
+        ext->y_scroll = scroll;
         SET_WIDGET_ABS_VALUES(h);                   /* Set new absolute values */
         gui_widget_invalidate(h);                   /* Invalidate widget */
         ret = 1;
@@ -2356,12 +2661,13 @@ gui_widget_setscrolly(gui_handle_p h, gui_dim_t scroll) {
  */
 uint8_t
 gui_widget_incscrollx(gui_handle_p h, gui_dim_t scroll) {
+    gui_handle_ext_t* ext;
     uint8_t ret = 0;
     
     GUI_ASSERTPARAMS(guii_widget_iswidget(h) && guii_widget_allowchildren(h));
     
-    if (scroll) {
-        h->x_scroll += scroll;
+    if (scroll && (ext = guii_widget_ext_create(h)) != NULL) {
+        ext->x_scroll += scroll;
         SET_WIDGET_ABS_VALUES(h);                   /* Set new absolute values */
         gui_widget_invalidate(h);                   /* Invalidate widget */
         ret = 1;
@@ -2379,12 +2685,13 @@ gui_widget_incscrollx(gui_handle_p h, gui_dim_t scroll) {
  */
 uint8_t
 gui_widget_incscrolly(gui_handle_p h, gui_dim_t scroll) {
+    gui_handle_ext_t* ext;
     uint8_t ret = 0;
     
     GUI_ASSERTPARAMS(guii_widget_iswidget(h) && guii_widget_allowchildren(h));
     
-    if (scroll) {
-        h->y_scroll += scroll;
+    if (scroll && (ext = guii_widget_ext_create(h)) != NULL) {
+        ext->y_scroll += scroll;
         SET_WIDGET_ABS_VALUES(h);                   /* Set new absolute values */
         gui_widget_invalidate(h);                   /* Invalidate widget */
         ret = 1;
@@ -2401,7 +2708,7 @@ gui_widget_incscrolly(gui_handle_p h, gui_dim_t scroll) {
 gui_dim_t
 gui_widget_getscrollx(gui_handle_p h) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h) && guii_widget_allowchildren(h));
-    return h->x_scroll;                             /* Get X scroll */
+    return guii_widget_ext(h)->x_scroll;            /* Get X scroll */
 }
 
 /**
@@ -2412,7 +2719,7 @@ gui_widget_getscrollx(gui_handle_p h) {
 gui_dim_t
 gui_widget_getscrolly(gui_handle_p h) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h) && guii_widget_allowchildren(h));
-    return h->y_scroll;                             /* Get Y scroll */
+    return guii_widget_ext(h)->y_scroll;            /* Get Y scroll */
 }
 
 /**
@@ -2429,13 +2736,23 @@ gui_widget_setfocus(gui_handle_p h) {
 
 /**
  * \brief           Set default font for widgets used on widget creation
+ *
+ *                  Font of already created widgets is not changed.
+ *                  When \ref GUI_CFG_WIDGET_LAZY_EXT is enabled, widgets without own values
+ *                  get them allocated with previous default font first
+ *
  * \param[in]       font: Pointer to \ref gui_font_t with font
  * \return          `1` on success, `0` otherwise
  */
 uint8_t
 gui_widget_setfontdefault(const gui_font_t* font) {
     GUI_ASSERTPARAMS(font != NULL);               
-    widget_default.font = font;                     /* Set default font */
+#if GUI_CFG_WIDGET_LAZY_EXT
+    if (guii_widget_ext_default.font != font && !ext_snapshot(NULL)) {
+        return 0;                                   /* Existing widgets would change font */
+    }
+#endif /* GUI_CFG_WIDGET_LAZY_EXT */
+    guii_widget_ext_default.font = font;            /* Set default font */
     return 1;
 }
 
@@ -2468,11 +2785,16 @@ gui_widget_incselection(gui_handle_p h, int16_t dir) {
  */
 uint8_t
 gui_widget_setzindex(gui_handle_p h, int32_t zindex) {
+    gui_handle_ext_t* ext;
+    
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
     
-    if (h->zindex != zindex) {                      /* There was a change in z-index value */
-        int32_t current = h->zindex;
-        h->zindex = zindex;                         /* Set new index */
+    if (guii_widget_ext(h)->zindex != zindex) {     /* There was a change in z-index value */
+        int32_t current = guii_widget_ext(h)->zindex;
+        if ((ext = guii_widget_ext_create(h)) == NULL) {
+            return 0;
+        }
+        ext->zindex = zindex;                       /* Set new index */
         if (zindex < current) {                     /* New index value is less important than before = move widget to top */
             gui_linkedlist_widgetmovetotop(h);      /* Move widget to top on linked list = less important and less visible */
         } else {
@@ -2491,7 +2813,7 @@ gui_widget_setzindex(gui_handle_p h, int32_t zindex) {
 int32_t
 gui_widget_getzindex(gui_handle_p h) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-    return h->zindex;                               /* Get z-index value */
+    return guii_widget_ext(h)->zindex;              /* Get z-index value */
 }
 
 /**
@@ -2540,6 +2862,29 @@ gui_widget_getalpha(gui_handle_p h) {
     return a;
 }
 
+/**
+ * \brief           Set one or more paddings of widget
+ * \param[in]       h: Widget handle
+ * \param[in]       mask: Bytes of paddings to set, MSB = top padding, LSB = left padding
+ * \param[in]       x: Padding in units of pixels
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+set_widget_padding(gui_handle_p h, uint32_t mask, gui_dim_t x) {
+    gui_handle_ext_t* ext;
+    uint32_t padding;
+    
+    padding = (guii_widget_ext(h)->padding & ~mask) | (((uint32_t)(uint8_t)x * 0x01010101UL) & mask);
+    if (padding != guii_widget_ext(h)->padding) {
+        if ((ext = guii_widget_ext_create(h)) == NULL) {
+            return 0;
+        }
+        ext->padding = padding;
+        SET_WIDGET_ABS_VALUES(h);
+    }
+    return 1;
+}
+
 /**
  * \brief           Set widget top padding
  * \param[in]       h: Widget handle
@@ -2549,11 +2894,7 @@ gui_widget_getalpha(gui_handle_p h) {
 uint8_t
 gui_widget_setpaddingtop(gui_handle_p h, gui_dim_t x) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-
-    h->padding = (uint32_t)((h->padding & 0x00FFFFFFUL) | (uint32_t)((uint8_t)x) << 24);/* Padding top */
-    SET_WIDGET_ABS_VALUES(h);
-    
-    return 1;
+    return set_widget_padding(h, 0xFF000000UL, x);
 }
 
 /**
@@ -2565,11 +2906,7 @@ gui_widget_setpaddingtop(gui_handle_p h, gui_dim_t x) {
 uint8_t
 gui_widget_setpaddingright(gui_handle_p h, gui_dim_t x) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-
-    h->padding = (uint32_t)((h->padding & 0xFF00FFFFUL) | (uint32_t)((uint8_t)x) << 16);/* Padding right */
-    SET_WIDGET_ABS_VALUES(h);
-    
-    return 1;
+    return set_widget_padding(h, 0x00FF0000UL, x);
 }
 
 /**
@@ -2581,11 +2918,7 @@ gui_widget_setpaddingright(gui_handle_p h, gui_dim_t x) {
 uint8_t
 gui_widget_setpaddingbottom(gui_handle_p h, gui_dim_t x) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-
-    h->padding = (uint32_t)((h->padding & 0xFFFF00FFUL) | (uint32_t)((uint8_t)x) << 8); /* Padding bottom */
-    SET_WIDGET_ABS_VALUES(h);
-    
-    return 1;
+    return set_widget_padding(h, 0x0000FF00UL, x);
 }
 
 /**
@@ -2597,11 +2930,7 @@ gui_widget_setpaddingbottom(gui_handle_p h, gui_dim_t x) {
 uint8_t
 gui_widget_setpaddingleft(gui_handle_p h, gui_dim_t x) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-
-    h->padding = (uint32_t)((h->padding & 0xFFFFFF00UL) | (uint32_t)((uint8_t)x) << 0); /* Padding left */
-    SET_WIDGET_ABS_VALUES(h);
-    
-    return 1;
+    return set_widget_padding(h, 0x000000FFUL, x);
 }
 
 /**
@@ -2613,12 +2942,7 @@ gui_widget_setpaddingleft(gui_handle_p h, gui_dim_t x) {
 uint8_t
 gui_widget_setpaddingtopbottom(gui_handle_p h, gui_dim_t x) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-
-    h->padding = (uint32_t)((h->padding & 0x00FFFFFFUL) | (uint32_t)((uint8_t)x) << 24);/* Padding top */
-    h->padding = (uint32_t)((h->padding & 0xFFFF00FFUL) | (uint32_t)((uint8_t)x) << 8); /* Padding bottom */
-    SET_WIDGET_ABS_VALUES(h);
-    
-    return 1;
+    return set_widget_padding(h, 0xFF00FF00UL, x);
 }
 
 /**
@@ -2630,12 +2954,7 @@ gui_widget_setpaddingtopbottom(gui_handle_p h, gui_dim_t x) {
 uint8_t
 gui_widget_setpaddingleftright(gui_handle_p h, gui_dim_t x) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-
-    h->padding = (uint32_t)((h->padding & 0xFF00FFFFUL) | (uint32_t)((uint8_t)x) << 16);/* Padding right */
-    h->padding = (uint32_t)((h->padding & 0xFFFFFF00UL) | (uint32_t)((uint8_t)x) << 0); /* Padding left */
-    SET_WIDGET_ABS_VALUES(h);
-    
-    return 1;
+    return set_widget_padding(h, 0x00FF00FFUL, x);
 }
 
 /**
@@ -2647,14 +2966,7 @@ gui_widget_setpaddingleftright(gui_handle_p h, gui_dim_t x) {
 uint8_t
 gui_widget_setpadding(gui_handle_p h, gui_dim_t x) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-    
-    h->padding = (uint32_t)((h->padding & 0x00FFFFFFUL) | (uint32_t)((uint8_t)x) << 24);/* Padding top */
-    h->padding = (uint32_t)((h->padding & 0xFF00FFFFUL) | (uint32_t)((uint8_t)x) << 16);/* Padding right */
-    h->padding = (uint32_t)((h->padding & 0xFFFF00FFUL) | (uint32_t)((uint8_t)x) << 8); /* Padding bottom */
-    h->padding = (uint32_t)((h->padding & 0xFFFFFF00UL) | (uint32_t)((uint8_t)x) << 0); /* Padding left */
-    SET_WIDGET_ABS_VALUES(h);
-    
-    return 1;
+    return set_widget_padding(h, 0xFFFFFFFFUL, x);
 }
 
 /**
@@ -2665,7 +2977,7 @@ gui_widget_setpadding(gui_handle_p h, gui_dim_t x) {
 gui_dim_t
 gui_widget_getpaddingtop(gui_handle_p h) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-    return GUI_DIM((h->padding >> 24) & 0xFF);
+    return GUI_DIM((guii_widget_ext(h)->padding >> 24) & 0xFF);
 }
 
 /**
@@ -2676,7 +2988,7 @@ gui_widget_getpaddingtop(gui_handle_p h) {
 gui_dim_t
 gui_widget_getpaddingright(gui_handle_p h) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-    return GUI_DIM((h->padding >> 16) & 0xFF);
+    return GUI_DIM((guii_widget_ext(h)->padding >> 16) & 0xFF);
 }
 
 /**
@@ -2687,7 +2999,7 @@ gui_widget_getpaddingright(gui_handle_p h) {
 gui_dim_t
 gui_widget_getpaddingbottom(gui_handle_p h) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-    return GUI_DIM((h->padding >> 8) & 0xFF);
+    return GUI_DIM((guii_widget_ext(h)->padding >> 8) & 0xFF);
 }
 
 /**
@@ -2698,5 +3010,5 @@ gui_widget_getpaddingbottom(gui_handle_p h) {
 gui_dim_t
 gui_widget_getpaddingleft(gui_handle_p h) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
-    return GUI_DIM((h->padding >> 0) & 0xFF);
+    return GUI_DIM((guii_widget_ext(h)->padding >> 0) & 0xFF);
 }
@@ -0,0 +1,115 @@
+/**	
+ * \file            gui_widget_tree.c
+ * \brief           Static widget trees
+ */
+ 
+/*
+ * Copyright (c) 2017 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+#define GUI_INTERNAL
+#include "gui/gui_private.h"
+#include "widget/gui_widget_tree.h"
+
+#if GUI_CFG_USE_WIDGET_TREE || __DOXYGEN__
+
+/**
+ * \brief           Create all widgets of widget tree
+ * \note            Widgets take memory from static block in order of entries.
+ *                  Every widget needs size of its structure, aligned to \ref GUI_CFG_MEM_ALIGNMENT bytes.
+ *                  Memory block must stay valid until all widgets of tree are removed
+ * \note            Every widget is invalidated once when created, to set its position on screen.
+ *                  Other invalidations are ignored until tree is complete, then top widgets are invalidated
+ * \param[in]       entries: Pointer to table of entries, can be in read-only memory
+ * \param[in]       count: Number of entries in table
+ * \param[out]      handles: Pointer to array of at least `count` elements to save widget handles.
+ *                      Handle is saved on the same index as its entry in table
+ * \param[in]       mem: Pointer to static memory block for widgets
+ * \param[in]       mem_size: Size of memory block in units of bytes
+ * \param[in]       parent: Parent widget for entries without parent entry.
+ *                      Set to `NULL` to use current active parent widget
+ * \return          `1` on success, `0` otherwise. On failure, already created widgets are removed
+ *                      before function returns and memory block can be used again
+ */
+uint8_t
+gui_widget_tree_create(const gui_widget_tree_entry_t* entries, size_t count, gui_handle_p* handles, void* mem, size_t mem_size, gui_handle_p parent) {
+    const gui_widget_tree_entry_t* e;
+    gui_handle_p h;
+    size_t i, align;
+    
+    GUI_ASSERTPARAMS(entries != NULL && count > 0 && handles != NULL && mem != NULL && GUI.widget_block.mem == NULL);
+    
+    align = GUI_MEM_ALIGN((size_t)mem) - (size_t)mem;   /* Number of bytes to aligned start of block */
+    if (align >= mem_size) {
+        return 0;
+    }
+    GUI.widget_block.mem = (uint8_t *)mem + align;  /* Widgets are created in static memory block from now */
+    GUI.widget_block.size = mem_size - align;
+    
+    for (i = 0; i < count; i++) {
+        e = &entries[i];
+        h = NULL;
+        if (e->parent == GUI_WIDGET_TREE_PARENT_NONE || e->parent < i) {   /* Parent must be created already */
+            h = e->create(e->id, e->x, e->y, e->width, e->height,
+                e->parent == GUI_WIDGET_TREE_PARENT_NONE ? parent : handles[e->parent],
+                e->evt_fn, e->flags | GUI_FLAG_WIDGET_CREATE_IGNORE_INVALIDATE);
+        }
+        if (h == NULL) {
+            break;
+        }
+        handles[i] = h;
+        if (e->text != NULL) {
+            gui_widget_settext(h, e->text);         /* Use text pointer directly */
+        }
+    }
+    GUI.widget_block.mem = NULL;                    /* Widgets are allocated from pool again */
+    GUI.widget_block.size = 0;
+    
+    if (i < count) {                                /* Tree is not complete */
+        while (i-- > 0) {
+            if (entries[i].parent == GUI_WIDGET_TREE_PARENT_NONE) {
+                guii_widget_removenow(handles[i]);  /* Remove top widgets, children are removed with them */
+            }
+            handles[i] = NULL;
+        }
+        return 0;
+    }
+    
+    /* Enable invalidation and invalidate top widgets, children are redrawn with them */
+    for (i = 0; i < count; i++) {
+        if (!GUI_CFG_WIDGET_CREATE_IGNORE_INVALIDATE && !(entries[i].flags & GUI_FLAG_WIDGET_CREATE_IGNORE_INVALIDATE)) {
+            guii_widget_clrflag(handles[i], GUI_FLAG_IGNORE_INVALIDATE);
+        }
+    }
+    for (i = 0; i < count; i++) {
+        if (entries[i].parent == GUI_WIDGET_TREE_PARENT_NONE) {
+            gui_widget_invalidate(handles[i]);
+        }
+    }
+    return 1;
+}
+
+#endif /* GUI_CFG_USE_WIDGET_TREE || __DOXYGEN__ */
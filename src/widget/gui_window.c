@@ -350,5 +350,5 @@ gui_window_setactive(gui_handle_p h) {
  */
 gui_handle_p
 gui_window_getdesktop(void) {
-    return (gui_handle_p)gui_linkedlist_getnext_gen(&GUI.root, NULL);   /* Return desktop window */
+    return gui_linkedlist_widgetgetnext(NULL, NULL);                    /* Return desktop window */
 }